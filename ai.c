@@ -0,0 +1,189 @@
+/** @file ai.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Computer opponent for single-player games.
+*/
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "system.h"
+#include "fixed.h"
+#include "geometry.h"
+#include "projectile.h"
+#include "game.h"
+#include "ai.h"
+
+#define PADDLE_STEPS (BALL_TASK_RATE * PADDLE_REPEAT_MS / 1000) //ball steps per paddle move
+#define PADDLE_REACH ((PADDLE_LENGTH - 1) / 2)  //cells either side of the middle of the paddle
+#define PADDLE_MIN PADDLE_REACH
+#define PADDLE_MAX (COURT_MAX_X - PADDLE_REACH)
+#define COURT_SPAN ((int32_t)FIXED(COURT_MAX_X) * 2)
+
+//Columns of the skill table
+enum {SKILL_REACTION, SKILL_ERROR, SKILL_FIELDS};
+
+/** Ball steps before the AI starts moving, and the most cells its aim
+    can be off by, for each skill level. */
+static const uint8_t skill_table[AI_SKILL_LEVELS][SKILL_FIELDS] PROGMEM = {
+    {15, 2},
+    {8, 1},
+    {3, 1},
+    {0, 0}
+};
+
+
+/** Returns the next number from the AI's xorshift generator.
+    @param ai AI whose generator is used
+    @return pseudo-random 32-bit number */
+static uint32_t ai_random(Ai* ai)
+{
+    uint32_t x = ai->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    ai->seed = x;
+    return x;
+}
+
+
+/** Counts the ball steps needed to cover a distance along y.
+    @param distance Distance to cover
+    @param speed Change in y per ball step, above 0
+    @return steps, rounded up */
+static uint16_t steps_to_cover(fixed_t distance, fixed_t speed)
+{
+    return (distance + speed - 1) / speed;
+}
+
+
+/** Works out where a ball just hit off the AI's paddle leaves its court,
+    and turns it round into the player's frame, as turn_projectile() and
+    the packet decoder would.
+    @param ai AI sending the ball
+    @param ball Ball on the AI's paddle row, moving up */
+static void send_back(Ai* ai, const Projectile* ball)
+{
+    bool mirrored;
+    uint16_t steps = FIXED(COURT_MAX_Y) / ball->delta_y + 1;
+    fixed_t x = ai_predict_x(ball->x, ball->delta_x, steps, &mirrored);
+    uint8_t heading = mirrored ? SERVE_COUNT - 1 - ball->heading : ball->heading;
+
+    ai->ball.x = FIXED(COURT_MAX_X) - x;
+    ai->ball.y = FIXED(COURT_MAX_Y);
+    projectile_aim(&ai->ball, SERVE_COUNT - 1 - heading, ball->speed, 1);
+    ai->steps_left += steps;
+}
+
+
+/** Serves from the AI's serve spot in a random direction, handing the
+    ball to the player after AI_SERVE_STEPS ball steps.
+    @param ai AI to serve */
+void ai_serve(Ai* ai)
+{
+    Projectile ball = projectile_init(ai_random(ai) % SERVE_COUNT);
+    ai->paddle = COURT_MAX_X / 2;
+    ai->steps_left = AI_SERVE_STEPS;
+    send_back(ai, &ball);
+}
+
+
+/** Sets up an AI opponent with an empty court.
+    @param ai AI to set up
+    @param skill 0 (slowest, least accurate) to AI_SKILL_LEVELS - 1
+    @param seed Seed for the AI's mistakes */
+void ai_init(Ai* ai, uint8_t skill, uint32_t seed)
+{
+    ai->steps_left = 0;
+    ai->missed = 0;
+    ai->paddle = COURT_MAX_X / 2;
+    ai->skill = skill < AI_SKILL_LEVELS ? skill : AI_SKILL_LEVELS - 1;
+    ai->seed = seed ? seed : 1;
+}
+
+
+/** Works out where the ball will reach the AI's paddle row along x,
+    reflecting it off the side walls in closed form.
+    @param x Position across the court
+    @param delta_x Change in x per ball step
+    @param steps Ball steps to look ahead
+    @param mirrored Set to 1 if an odd number of wall bounces reverse the ball
+    @return x after steps ball steps, between 0 and FIXED(COURT_MAX_X) */
+fixed_t ai_predict_x(fixed_t x, fixed_t delta_x, uint16_t steps, bool* mirrored)
+{
+    //Unfolds the court into copies mirrored at each wall, so the ball
+    //travels in a straight line, then folds the end point back
+    int32_t unfolded = ((int32_t)x + (int32_t)delta_x * steps) % COURT_SPAN;
+    if (unfolded < 0) {
+        unfolded += COURT_SPAN;
+    }
+    *mirrored = unfolded > FIXED(COURT_MAX_X);
+    return *mirrored ? COURT_SPAN - unfolded : unfolded;
+}
+
+
+/** Takes the ball as it leaves the player's court, and works out at once
+    whether and how the AI returns it.
+    @param ai AI to hand the ball to
+    @param projectile Ball as turned by turn_projectile(), in the AI's frame */
+void ai_receive(Ai* ai, const Projectile* projectile)
+{
+    Projectile ball = *projectile;
+    bool mirrored;
+    uint8_t reaction = pgm_read_byte(&skill_table[ai->skill][SKILL_REACTION]);
+    uint8_t error = pgm_read_byte(&skill_table[ai->skill][SKILL_ERROR]);
+
+    //Where the ball reaches the paddle row, and when
+    ball.y = FIXED(COURT_MAX_Y);
+    projectile_aim(&ball, ball.heading, ball.speed, 1);
+    ai->steps_left = steps_to_cover(FIXED(COURT_MAX_Y), -ball.delta_y);
+    ball.x = ai_predict_x(ball.x, ball.delta_x, ai->steps_left, &mirrored);
+    if (mirrored) {
+        ball.heading = SERVE_COUNT - 1 - ball.heading;
+    }
+    int8_t landing = FIXED_TO_CELL(ball.x);
+
+    //Aims for the landing cell, give or take its error, after reacting
+    int8_t target = landing + (int8_t)(ai_random(ai) % (2 * error + 1)) - error;
+    if (target < PADDLE_MIN) {
+        target = PADDLE_MIN;
+    } else if (target > PADDLE_MAX) {
+        target = PADDLE_MAX;
+    }
+    uint16_t moves = ai->steps_left > reaction ? (ai->steps_left - reaction) / PADDLE_STEPS : 0;
+    if (target > ai->paddle) {
+        ai->paddle = target - ai->paddle > moves ? ai->paddle + moves : target;
+    } else {
+        ai->paddle = ai->paddle - target > moves ? ai->paddle - moves : target;
+    }
+
+    int8_t offset = landing - ai->paddle;
+    ai->missed = offset < -PADDLE_REACH || offset > PADDLE_REACH;
+    if (!ai->missed) {
+        ball.y = 0;
+        projectile_return(&ball, offset);
+        send_back(ai, &ball);
+    }
+}
+
+
+/** Moves the ball on the AI's court on by one ball step. Call at the ball
+    rate while WAITING.
+    @param ai AI holding the ball
+    @param projectile Set to the ball coming back when AI_RETURNED
+    @return AI_RETURNED when the ball comes back onto the player's top
+    row, AI_MISSED when the AI misses it, otherwise AI_BUSY */
+Ai_Event ai_step(Ai* ai, Projectile* projectile)
+{
+    if (ai->steps_left > 1) {
+        ai->steps_left--;
+        return AI_BUSY;
+    }
+    if (ai->missed) {
+        ai->missed = 0;
+        ai_serve(ai);
+        return AI_MISSED;
+    }
+    ai->steps_left = 0;
+    *projectile = ai->ball;
+    return AI_RETURNED;
+}
@@ -0,0 +1,83 @@
+/** @file ai.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Computer opponent for single-player games.
+
+    The far court is not simulated step by step. When the ball leaves the
+    player's court, ai_receive() works out in closed form where it will
+    reach the AI's paddle row, by unfolding its path across the side walls,
+    and whether the AI's paddle gets there in time. ai_step() then hands
+    the ball back, or reports a miss, after as many ball steps as the
+    flight would have taken. Skill sets how long the AI takes to react
+    and how far off its aim can be.
+*/
+
+#ifndef AI_H
+#define AI_H
+
+#include <stdint.h>
+#include "system.h"
+#include "fixed.h"
+#include "projectile.h"
+
+#define AI_SKILL_LEVELS 4
+#define AI_DEFAULT_SKILL 2
+#define AI_SERVE_STEPS 50  //ball steps from a miss by the AI to its serve
+
+//Defines what happened to the ball on the AI's court during a step
+typedef enum {
+    AI_BUSY,      //still on the AI's court
+    AI_RETURNED,  //sent back to the player
+    AI_MISSED     //the AI missed it, and will serve next
+} Ai_Event;
+
+//Defines the AI opponent and the ball it holds
+typedef struct {
+    Projectile ball;     //ball to send back, already in the player's frame
+    uint16_t steps_left; //ball steps until it is sent back, or missed
+    bool missed;         //1 if the AI will miss the ball it holds
+    int8_t paddle;       //cell the middle of the AI's paddle is on
+    uint8_t skill;
+    uint32_t seed;
+} Ai;
+
+
+/** Sets up an AI opponent with an empty court.
+    @param ai AI to set up
+    @param skill 0 (slowest, least accurate) to AI_SKILL_LEVELS - 1
+    @param seed Seed for the AI's mistakes */
+void ai_init(Ai* ai, uint8_t skill, uint32_t seed);
+
+
+/** Works out where the ball will reach the AI's paddle row along x,
+    reflecting it off the side walls in closed form.
+    @param x Position across the court
+    @param delta_x Change in x per ball step
+    @param steps Ball steps to look ahead
+    @param mirrored Set to 1 if an odd number of wall bounces reverse the ball
+    @return x after steps ball steps, between 0 and FIXED(COURT_MAX_X) */
+fixed_t ai_predict_x(fixed_t x, fixed_t delta_x, uint16_t steps, bool* mirrored);
+
+
+/** Takes the ball as it leaves the player's court, and works out at once
+    whether and how the AI returns it.
+    @param ai AI to hand the ball to
+    @param projectile Ball as turned by turn_projectile(), in the AI's frame */
+void ai_receive(Ai* ai, const Projectile* projectile);
+
+
+/** Serves from the AI's serve spot in a random direction, handing the
+    ball to the player after AI_SERVE_STEPS ball steps.
+    @param ai AI to serve */
+void ai_serve(Ai* ai);
+
+
+/** Moves the ball on the AI's court on by one ball step. Call at the ball
+    rate while WAITING.
+    @param ai AI holding the ball
+    @param projectile Set to the ball coming back when AI_RETURNED
+    @return AI_RETURNED when the ball comes back onto the player's top
+    row, AI_MISSED when the AI misses it, otherwise AI_BUSY */
+Ai_Event ai_step(Ai* ai, Projectile* projectile);
+
+#endif //AI_H
@@ -0,0 +1,87 @@
+/** @file anim.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Non-blocking frame animations on the overlay layer.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <avr/pgmspace.h>
+#include "system.h"
+#include "framebuffer.h"
+#include "anim.h"
+
+/** Animation playing, in program memory, or NULL when idle. */
+static const Animation* current;
+
+/** Copy of the playing animation. */
+static Animation playing;
+
+/** Frame being shown, and ticks left before the next one. */
+static uint8_t frame;
+static uint8_t ticks_left;
+
+
+/** Draws the current frame and starts its countdown. */
+static void show_frame(void)
+{
+    Anim_Frame shown;
+    memcpy_P(&shown, &playing.frames[frame], sizeof(shown));
+    framebuffer_blit_P(LAYER_OVERLAY, shown.bitmap);
+    ticks_left = shown.ticks ? shown.ticks : 1;
+}
+
+
+/** Starts an animation from its first frame, replacing any other.
+    Does nothing if it is already playing.
+    @param animation Animation to play, in program memory */
+void anim_play(const Animation* animation)
+{
+    if (animation == current) {
+        return;
+    }
+    current = animation;
+    memcpy_P(&playing, animation, sizeof(playing));
+    frame = 0;
+    framebuffer_show(playing.flags & ANIM_SOLO ? 1 << LAYER_OVERLAY : FRAMEBUFFER_ALL_LAYERS);
+    show_frame();
+}
+
+
+/** Moves the playing animation on by one tick. Call at the animation rate. */
+void anim_step(void)
+{
+    if (current == NULL || --ticks_left) {
+        return;
+    }
+    frame++;
+    if (frame >= playing.count) {
+        if (!(playing.flags & ANIM_LOOP)) {
+            anim_stop();
+            return;
+        }
+        frame = 0;
+    }
+    show_frame();
+}
+
+
+/** Stops the playing animation and clears what it drew. */
+void anim_stop(void)
+{
+    if (current == NULL) {
+        return;
+    }
+    current = NULL;
+    framebuffer_clear(LAYER_OVERLAY);
+    framebuffer_show(FRAMEBUFFER_ALL_LAYERS);
+}
+
+
+/** Checks if an animation that ends by itself is still playing.
+    Looping animations never count as busy.
+    @return 1 while a one-shot animation is playing */
+bool anim_busy(void)
+{
+    return current != NULL && !(playing.flags & ANIM_LOOP);
+}
@@ -0,0 +1,62 @@
+/** @file anim.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Non-blocking frame animations on the overlay layer.
+
+    An animation is a list of bitmaps in flash, each held for a number of
+    animation ticks. anim_play() starts one and returns at once; anim_step()
+    is called once per tick by the animation task and moves it on, so the
+    rest of the game keeps running while it plays. Animations are listed in
+    assets.def.
+*/
+
+#ifndef ANIM_H
+#define ANIM_H
+
+#include <stdint.h>
+#include "system.h"
+#include "geometry.h"
+
+/*Length of one animation tick in ms. Frame times in assets.def are given
+    in ms and rounded down to whole ticks*/
+#define ANIM_TICK_MS 20
+#define ANIM_TICKS(ms) ((ms) / ANIM_TICK_MS)
+
+//Animation flags
+#define ANIM_LOOP 1  //starts again from the first frame instead of stopping
+#define ANIM_SOLO 2  //hides the other layers while it plays
+
+//Defines one frame: a bitmap in flash, shown for a number of ticks
+typedef struct {
+    const column_t* bitmap;
+    uint8_t ticks;
+} Anim_Frame;
+
+//Defines an animation, kept in flash
+typedef struct {
+    const Anim_Frame* frames;
+    uint8_t count;
+    uint8_t flags;
+} Animation;
+
+
+/** Starts an animation from its first frame, replacing any other.
+    Does nothing if it is already playing.
+    @param animation Animation to play, in program memory */
+void anim_play(const Animation* animation);
+
+
+/** Moves the playing animation on by one tick. Call at the animation rate. */
+void anim_step(void);
+
+
+/** Stops the playing animation and clears what it drew. */
+void anim_stop(void);
+
+
+/** Checks if an animation that ends by itself is still playing.
+    Looping animations never count as busy.
+    @return 1 while a one-shot animation is playing */
+bool anim_busy(void);
+
+#endif //ANIM_H
@@ -0,0 +1,24 @@
+/** @file assets.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Strings, bitmaps and animations kept in flash, generated from assets.def.
+*/
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "assets.h"
+
+#define TEXT(name, string) const char text_##name[] PROGMEM = string;
+#define BITMAP(name, c0, c1, c2, c3, c4) const column_t bitmap_##name[FRAMEBUFFER_COLS] PROGMEM = {c0, c1, c2, c3, c4};
+#define FRAME(bitmap, ms) {bitmap_##bitmap, ANIM_TICKS(ms)}
+#define ANIMATION(name, flags, ...) \
+    static const Anim_Frame frames_##name[] PROGMEM = {__VA_ARGS__}; \
+    const Animation animation_##name PROGMEM = \
+        {frames_##name, sizeof(frames_##name) / sizeof(frames_##name[0]), flags};
+#define GLYPHS(string)
+#include "assets.def"
+#undef TEXT
+#undef BITMAP
+#undef FRAME
+#undef ANIMATION
+#undef GLYPHS
@@ -0,0 +1,29 @@
+/** @file assets.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Strings, bitmaps and animations kept in flash, generated from assets.def.
+
+    text_NAME[], bitmap_NAME[] and animation_NAME live in program memory, so
+    they cost no RAM; read them with pgm_read_byte(), or hand them to
+    text_scroll_P(), framebuffer_blit_P() and anim_play().
+*/
+
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "framebuffer.h"
+#include "anim.h"
+
+#define TEXT(name, string) extern const char text_##name[] PROGMEM;
+#define BITMAP(name, c0, c1, c2, c3, c4) extern const column_t bitmap_##name[FRAMEBUFFER_COLS] PROGMEM;
+#define ANIMATION(name, flags, ...) extern const Animation animation_##name PROGMEM;
+#define GLYPHS(string)
+#include "assets.def"
+#undef TEXT
+#undef BITMAP
+#undef ANIMATION
+#undef GLYPHS
+
+#endif //ASSETS_H
@@ -0,0 +1,225 @@
+/** @file balls.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Pool of the balls in play on this court.
+*/
+
+#include <stdint.h>
+#include "system.h"
+#include "fixed.h"
+#include "paddle.h"
+#include "projectile.h"
+#include "framebuffer.h"
+#include "packet.h"
+#include "court.h"
+#include "balls.h"
+
+#if BALL_POOL_SIZE > (1 << PACKET_BALL_ID_BITS)
+#error "ball IDs do not fit in a packet"
+#endif
+
+
+/** Works out which court columns the paddle covers, as a row of the
+    court bitboard. This is the paddle's display column.
+    @param top y-coordinate of the top of the paddle
+    @param bottom y-coordinate of the bottom of the paddle
+    @return COURT_CELL(x) set if the paddle covers column x */
+static column_t paddle_span(int8_t top, int8_t bottom)
+{
+    if (top < bottom) {
+        return 0;
+    }
+    return (((column_t)1 << (top - bottom + 1)) - 1) << bottom;
+}
+
+
+/** Bounces a ball off the obstacle it is about to move into. Tests the
+    cells beside and in front of it to tell which way it hit; hitting
+    just a corner turns it straight back. Breaks any brick it hits. A
+    ball that bounces holds its place for the step, so the paddle and
+    walls are checked against its new velocity before it moves again.
+    @param pool Address of the Ball_Pool object.
+    @param id Ball to bounce
+    @param map Address of the court bitboard
+    @return 1 if the ball can move on, 0 if it bounced */
+static bool bounce_obstacles(Ball_Pool* pool, uint8_t id, Court_Map* map)
+{
+    int8_t x = FIXED_TO_CELL(pool->x[id]);
+    int8_t y = FIXED_TO_CELL(pool->y[id]);
+    int8_t next_x = FIXED_TO_CELL(pool->x[id] + pool->dx[id]);
+    int8_t next_y = FIXED_TO_CELL(pool->y[id] + pool->dy[id]);
+
+    if (!COURT_BLOCKED(map, next_x, next_y)) {
+        return 1;
+    }
+    bool side = COURT_BLOCKED(map, next_x, y) != 0;
+    bool front = COURT_BLOCKED(map, x, next_y) != 0;
+    if (!side && !front) {
+        side = front = 1;
+    }
+    if (side) {
+        court_hit(map, next_x, y);
+        pool->dx[id] = -pool->dx[id];
+        pool->heading[id] = SERVE_COUNT - 1 - pool->heading[id];
+    }
+    if (front) {
+        court_hit(map, x, next_y);
+        pool->dy[id] = -pool->dy[id];
+    }
+    if (side && front) {
+        court_hit(map, next_x, next_y);
+    }
+    return 0;
+}
+
+
+/** Empties the pool.
+    @param pool Address of the Ball_Pool object. */
+void ball_pool_clear(Ball_Pool* pool)
+{
+    pool->live = 0;
+}
+
+
+/** Serves balls from the serve spot, the first along the chosen heading
+    and the rest fanned out either side of it.
+    @param pool Address of the Ball_Pool object, emptied first
+    @param heading Heading chosen for the first ball
+    @param count Balls to serve, up to BALL_POOL_SIZE */
+void ball_pool_serve(Ball_Pool* pool, Start_Position heading, uint8_t count)
+{
+    ball_pool_clear(pool);
+    for (uint8_t id = 0; id < count && id < BALL_POOL_SIZE; id++) {
+        //0, +spread, -spread, +2 spread, ... clamped to the court
+        int8_t fan = (id + 1) / 2 * MULTI_BALL_SPREAD;
+        int8_t ball_heading = heading + (id % 2 ? fan : -fan);
+        if (ball_heading < 0) {
+            ball_heading = 0;
+        } else if (ball_heading >= SERVE_COUNT) {
+            ball_heading = SERVE_COUNT - 1;
+        }
+        Projectile ball = projectile_init(ball_heading);
+        ball_pool_put(pool, id, &ball);
+    }
+}
+
+
+/** Puts a ball into play in a given slot.
+    @param pool Address of the Ball_Pool object.
+    @param id Slot to use
+    @param projectile Ball to copy in
+    @return 1 if put, 0 if the slot already holds a ball in play */
+bool ball_pool_put(Ball_Pool* pool, uint8_t id, const Projectile* projectile)
+{
+    if (id >= BALL_POOL_SIZE || pool->live & (1 << id)) {
+        return 0;
+    }
+    pool->x[id] = projectile->x;
+    pool->y[id] = projectile->y;
+    pool->dx[id] = projectile->delta_x;
+    pool->dy[id] = projectile->delta_y;
+    pool->heading[id] = projectile->heading;
+    pool->speed[id] = projectile->speed;
+    pool->live |= 1 << id;
+    return 1;
+}
+
+
+/** Reads a ball back out of its slot, whether or not it is still in play.
+    @param pool Address of the Ball_Pool object.
+    @param id Slot to read
+    @param projectile Projectile to write to */
+void ball_pool_get(const Ball_Pool* pool, uint8_t id, Projectile* projectile)
+{
+    projectile->x = pool->x[id];
+    projectile->y = pool->y[id];
+    projectile->delta_x = pool->dx[id];
+    projectile->delta_y = pool->dy[id];
+    projectile->heading = pool->heading[id];
+    projectile->speed = pool->speed[id];
+}
+
+
+/** Moves every ball in play on by one ball step, in a single pass.
+    Balls that cross the top edge or are missed are taken out of play.
+    @param pool Address of the Ball_Pool object.
+    @param paddle Address of the paddle
+    @param map Address of the court bitboard, whose bricks may be broken
+    @return masks of the balls returned, crossed and missed */
+Ball_Events ball_pool_step(Ball_Pool* pool, Paddle* paddle, Court_Map* map)
+{
+    Ball_Events events = {0, 0, 0};
+    int8_t top = get_paddle_top(paddle);
+    int8_t bottom = get_paddle_bottom(paddle);
+    column_t span = paddle_span(top, bottom);
+    int8_t mid = COURT_ROW((top + bottom) / 2);
+
+    //Visits only the balls in play
+    for (uint8_t id = 0, live = pool->live; live; id++, live >>= 1) {
+        uint8_t bit = 1 << id;
+        if (!(live & 1)) {
+            continue;
+        }
+        fixed_t next_y = pool->y[id] + pool->dy[id];
+        int8_t cell = FIXED_TO_CELL(pool->x[id]);
+
+        // Paddle collision, moving down onto a covered column
+        if (next_y <= 0 && pool->dy[id] < 0 && (span & COURT_CELL(cell))) {
+            Projectile ball;
+            ball_pool_get(pool, id, &ball);
+            projectile_return(&ball, cell - mid);
+            pool->y[id] = 0;
+            pool->dx[id] = ball.delta_x;
+            pool->dy[id] = ball.delta_y;
+            pool->heading[id] = ball.heading;
+            pool->speed[id] = ball.speed;
+            events.returned |= bit;
+        }
+
+        // Bottom edge (miss), or top edge, left where it crossed to be sent
+        else if (next_y < 0 || next_y > FIXED(COURT_MAX_Y)) {
+            if (next_y < 0) {
+                events.missed |= bit;
+            } else {
+                events.crossed |= bit;
+            }
+            pool->live &= ~bit;
+            continue;
+        }
+
+        // Left/right wall collision, mirroring the heading
+        if (pool->x[id] + pool->dx[id] < 0) {
+            pool->x[id] = 0;
+            pool->dx[id] = -pool->dx[id];
+            pool->heading[id] = SERVE_COUNT - 1 - pool->heading[id];
+        } else if (pool->x[id] + pool->dx[id] > FIXED(COURT_MAX_X)) {
+            pool->x[id] = FIXED(COURT_MAX_X);
+            pool->dx[id] = -pool->dx[id];
+            pool->heading[id] = SERVE_COUNT - 1 - pool->heading[id];
+        }
+
+        // Obstacles, then move unless it bounced off one
+        if (bounce_obstacles(pool, id, map)) {
+            pool->x[id] += pool->dx[id];
+            pool->y[id] += pool->dy[id];
+        }
+    }
+    return events;
+}
+
+
+/** Draws every ball in play on the ball layer.
+    @param pool Address of the Ball_Pool object. */
+void ball_pool_draw(const Ball_Pool* pool)
+{
+    column_t columns[FRAMEBUFFER_COLS] = {0};
+
+    for (uint8_t id = 0; id < BALL_POOL_SIZE; id++) {
+        if (pool->live & (1 << id)) {
+            columns[COURT_COL(FIXED_TO_CELL(pool->y[id]))] |= COURT_CELL(FIXED_TO_CELL(pool->x[id]));
+        }
+    }
+    for (uint8_t col = 0; col < FRAMEBUFFER_COLS; col++) {
+        framebuffer_column(LAYER_BALL, col, columns[col]);
+    }
+}
@@ -0,0 +1,95 @@
+/** @file balls.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Pool of the balls in play on this court.
+
+    Every ball on the court lives in one fixed-size pool, kept as parallel
+    arrays, one per field, so a single pass steps all of them together.
+    A ball's slot is its ID, which travels with it between courts. The
+    paddle is turned into a row of the court bitboard once per pass, and
+    each ball is tested against it, and against the obstacles in the
+    cell it is moving into, with a single AND each.
+
+    A ball that leaves the court is taken out of play, but its fields stay
+    in its slot until the slot is used again, so it can still be read back
+    with ball_pool_get() to be sent on.
+*/
+
+#ifndef BALLS_H
+#define BALLS_H
+
+#include <stdint.h>
+#include "system.h"
+#include "fixed.h"
+#include "paddle.h"
+#include "projectile.h"
+#include "court.h"
+
+/*Balls the pool holds, and how many a multi-ball serve puts into play,
+    fanned out MULTI_BALL_SPREAD headings apart. IDs must fit the packet*/
+#define BALL_POOL_SIZE 4
+#define BALL_NONE BALL_POOL_SIZE
+#define MULTI_BALL_COUNT 3
+#define MULTI_BALL_SPREAD 2
+
+//Defines the balls on this court, one slot of each array per ball ID
+typedef struct {
+    fixed_t x[BALL_POOL_SIZE];
+    fixed_t y[BALL_POOL_SIZE];
+    fixed_t dx[BALL_POOL_SIZE];
+    fixed_t dy[BALL_POOL_SIZE];
+    uint8_t heading[BALL_POOL_SIZE];
+    uint8_t speed[BALL_POOL_SIZE];
+    uint8_t live;  //bit n set while ball n is on this court
+} Ball_Pool;
+
+//Defines what happened to the balls in one step, as masks of ball IDs
+typedef struct {
+    uint8_t returned;  //hit the paddle
+    uint8_t crossed;   //left over the top edge, for the caller to send
+    uint8_t missed;    //got past the paddle
+} Ball_Events;
+
+
+/** Empties the pool.
+    @param pool Address of the Ball_Pool object. */
+void ball_pool_clear(Ball_Pool* pool);
+
+
+/** Serves balls from the serve spot, the first along the chosen heading
+    and the rest fanned out either side of it.
+    @param pool Address of the Ball_Pool object, emptied first
+    @param heading Heading chosen for the first ball
+    @param count Balls to serve, up to BALL_POOL_SIZE */
+void ball_pool_serve(Ball_Pool* pool, Start_Position heading, uint8_t count);
+
+
+/** Puts a ball into play in a given slot.
+    @param pool Address of the Ball_Pool object.
+    @param id Slot to use
+    @param projectile Ball to copy in
+    @return 1 if put, 0 if the slot already holds a ball in play */
+bool ball_pool_put(Ball_Pool* pool, uint8_t id, const Projectile* projectile);
+
+
+/** Reads a ball back out of its slot, whether or not it is still in play.
+    @param pool Address of the Ball_Pool object.
+    @param id Slot to read
+    @param projectile Projectile to write to */
+void ball_pool_get(const Ball_Pool* pool, uint8_t id, Projectile* projectile);
+
+
+/** Moves every ball in play on by one ball step, in a single pass.
+    Balls that cross the top edge or are missed are taken out of play.
+    @param pool Address of the Ball_Pool object.
+    @param paddle Address of the paddle
+    @param map Address of the court bitboard, whose bricks may be broken
+    @return masks of the balls returned, crossed and missed */
+Ball_Events ball_pool_step(Ball_Pool* pool, Paddle* paddle, Court_Map* map);
+
+
+/** Draws every ball in play on the ball layer.
+    @param pool Address of the Ball_Pool object. */
+void ball_pool_draw(const Ball_Pool* pool);
+
+#endif //BALLS_H
@@ -0,0 +1,92 @@
+/** @file court.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Court bitboard holding the obstacles of a level.
+*/
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "system.h"
+#include "framebuffer.h"
+#include "geometry.h"
+#include "court.h"
+
+//Columns of the level table
+enum {ROWS_SOLID, ROWS_BRICKS, ROWS_FIELDS};
+
+//Size of the level designs in levels.def, the inner rows of the UCFK4 court
+#define LEVEL_WIDTH 7
+#define LEVEL_ROWS 3
+
+/*Levels are copied row for row when the court is the design's size and
+    its bit order, and stretched to fit it otherwise*/
+#define LEVEL_FITS_P (LEVEL_WIDTH == COURT_WIDTH && LEVEL_ROWS == COURT_INNER_ROWS && COURT_FLIP_X)
+
+/** Inner rows of each level, generated from levels.def. */
+static const uint8_t level_table[LEVEL_COUNT][ROWS_FIELDS][LEVEL_ROWS] PROGMEM = {
+#define ROWS(...) {__VA_ARGS__}
+#define LEVEL(name, solid, bricks) {solid, bricks},
+#include "levels.def"
+#undef LEVEL
+#undef ROWS
+};
+
+
+/** Loads a level's obstacles from program memory.
+    @param map Address of the Court_Map object.
+    @param level Level to load, from levels.def */
+void court_load(Court_Map* map, Level level)
+{
+    if (level >= LEVEL_COUNT) {
+        level = LEVEL_OPEN;
+    }
+    *map = (Court_Map){{0}, {0}};
+#if LEVEL_FITS_P
+    for (uint8_t row = 0; row < COURT_INNER_ROWS; row++) {
+        uint8_t bricks = pgm_read_byte(&level_table[level][ROWS_BRICKS][row]);
+        map->bricks[row + 1] = bricks;
+        map->cells[row + 1] = pgm_read_byte(&level_table[level][ROWS_SOLID][row]) | bricks;
+    }
+#else
+    //Each design row goes in the middle of its share of the inner rows,
+    //and each cell of it covers its share of the columns
+    for (uint8_t row = 0; row < LEVEL_ROWS; row++) {
+        uint8_t y = 1 + (2 * row + 1) * COURT_INNER_ROWS / (2 * LEVEL_ROWS);
+        uint8_t bricks = pgm_read_byte(&level_table[level][ROWS_BRICKS][row]);
+        uint8_t solid = pgm_read_byte(&level_table[level][ROWS_SOLID][row]);
+        for (uint8_t x = 0; x < COURT_WIDTH; x++) {
+            uint8_t design_cell = 1 << (LEVEL_WIDTH - 1 - x * LEVEL_WIDTH / COURT_WIDTH);
+            if (bricks & design_cell) {
+                map->bricks[y] |= COURT_CELL(x);
+            }
+            if ((bricks | solid) & design_cell) {
+                map->cells[y] |= COURT_CELL(x);
+            }
+        }
+    }
+#endif
+}
+
+
+/** Breaks the brick at a cell, if there is one.
+    @param map Address of the Court_Map object.
+    @param x column of the cell
+    @param y row of the cell */
+void court_hit(Court_Map* map, int8_t x, int8_t y)
+{
+    if (map->bricks[y] & COURT_CELL(x)) {
+        map->bricks[y] &= ~COURT_CELL(x);
+        map->cells[y] &= ~COURT_CELL(x);
+    }
+}
+
+
+/** Draws the obstacles, one column write per inner row. The paddle row
+    is left to display_paddle().
+    @param map Address of the Court_Map object. */
+void court_draw(const Court_Map* map)
+{
+    for (uint8_t y = 1; y < COURT_ROWS; y++) {
+        framebuffer_column(LAYER_COURT, COURT_COL(y), map->cells[y]);
+    }
+}
@@ -0,0 +1,62 @@
+/** @file court.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Court bitboard holding the obstacles of a level.
+
+    The court is kept as one bitmask per row, in the same bit order as a
+    display column, so testing a cell is a single AND and drawing a row is
+    a single column write. Its size and orientation come from geometry.h.
+    Levels are loaded from program memory, from levels.def, into a copy in
+    RAM that bricks can be broken out of.
+*/
+
+#ifndef COURT_H
+#define COURT_H
+
+#include <stdint.h>
+#include "system.h"
+#include "geometry.h"
+
+#define COURT_ROWS (COURT_MAX_Y + 1)
+#define COURT_INNER_ROWS (COURT_MAX_Y - 1)
+
+/** Mask of the cell in court column x, within a row. */
+#define COURT_CELL(x) ((column_t)1 << COURT_ROW(x))
+
+/** Checks if the cell at (x, y) holds an obstacle. */
+#define COURT_BLOCKED(map, x, y) ((map)->cells[y] & COURT_CELL(x))
+
+//Defines the levels, from levels.def
+typedef enum {
+#define LEVEL(name, solid, bricks) LEVEL_##name,
+#include "levels.def"
+#undef LEVEL
+    LEVEL_COUNT
+} Level;
+
+//Defines the obstacles on this court, one mask per row
+typedef struct {
+    column_t cells[COURT_ROWS];   //every cell the ball bounces off
+    column_t bricks[COURT_ROWS];  //the cells of those that break when hit
+} Court_Map;
+
+
+/** Loads a level's obstacles from program memory.
+    @param map Address of the Court_Map object.
+    @param level Level to load, from levels.def */
+void court_load(Court_Map* map, Level level);
+
+
+/** Breaks the brick at a cell, if there is one.
+    @param map Address of the Court_Map object.
+    @param x column of the cell
+    @param y row of the cell */
+void court_hit(Court_Map* map, int8_t x, int8_t y);
+
+
+/** Draws the obstacles, one column write per inner row. The paddle row
+    is left to display_paddle().
+    @param map Address of the Court_Map object. */
+void court_draw(const Court_Map* map);
+
+#endif //COURT_H
@@ -0,0 +1,31 @@
+/** @file fixed.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Q8.8 fixed-point numbers for sub-pixel ball physics.
+
+    A fixed_t holds a signed number of cells with 8 fractional bits, so
+    256 is one cell. Only shifts, adds and integer multiplies are used,
+    which keeps floating point out of the AVR build.
+*/
+
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdint.h>
+
+typedef int16_t fixed_t;
+
+#define FIXED_SHIFT 8
+#define FIXED_ONE (1 << FIXED_SHIFT)
+#define FIXED_HALF (FIXED_ONE / 2)
+
+/** Converts whole cells to fixed point. */
+#define FIXED(cells) ((fixed_t)((cells) * FIXED_ONE))
+
+/** Rounds fixed point to the nearest whole cell. */
+#define FIXED_TO_CELL(value) ((int8_t)(((value) + FIXED_HALF) >> FIXED_SHIFT))
+
+/** Multiplies two fixed point numbers. */
+#define FIXED_MUL(a, b) ((fixed_t)(((int32_t)(a) * (b)) >> FIXED_SHIFT))
+
+#endif //FIXED_H
@@ -0,0 +1,139 @@
+/** @file framebuffer.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Layered framebuffer with a single column scan.
+*/
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "system.h"
+#include "ledmat.h"
+#include "geometry.h"
+#include "framebuffer.h"
+
+#if FRAMEBUFFER_COLS != LEDMAT_COLS_NUM || FRAMEBUFFER_ROWS != LEDMAT_ROWS_NUM
+#error "the court geometry does not match the LED matrix"
+#endif
+
+//Defines a mask with one bit per display column
+#if FRAMEBUFFER_COLS <= 8
+typedef uint8_t Column_Mask;
+#else
+typedef uint16_t Column_Mask;
+#endif
+
+/** Reads one column of a bitmap in program memory. */
+#if FRAMEBUFFER_ROWS <= 8
+#define pgm_read_column(address) pgm_read_byte(address)
+#else
+#define pgm_read_column(address) pgm_read_word(address)
+#endif
+
+/** Pixels of each layer, one column_t per column. */
+static column_t layers[LAYER_COUNT][FRAMEBUFFER_COLS];
+
+/** Combined pixels of all layers, as sent to the matrix. */
+static column_t screen[FRAMEBUFFER_COLS];
+
+/** Bit n set when layer n is shown. */
+static uint8_t shown;
+
+/** Bit n set when column n of the screen needs recombining. */
+static Column_Mask dirty;
+
+/** Column the next scan will drive. */
+static uint8_t scan_col;
+
+
+/** Clears every layer and restarts the scan at the first column. */
+void framebuffer_init(void)
+{
+    for (uint8_t col = 0; col < FRAMEBUFFER_COLS; col++) {
+        for (uint8_t layer = 0; layer < LAYER_COUNT; layer++) {
+            layers[layer][col] = 0;
+        }
+        screen[col] = 0;
+    }
+    shown = FRAMEBUFFER_ALL_LAYERS;
+    dirty = 0;
+    scan_col = 0;
+}
+
+
+/** Sets the pixels of one column of a layer.
+    @param layer Layer to draw on
+    @param col Display column
+    @param pattern Bitmap of the column, bit n is row n */
+void framebuffer_column(Layer layer, uint8_t col, column_t pattern)
+{
+    if (layers[layer][col] != pattern) {
+        layers[layer][col] = pattern;
+        dirty |= (Column_Mask)1 << col;
+    }
+}
+
+
+/** Clears a layer.
+    @param layer Layer to clear */
+void framebuffer_clear(Layer layer)
+{
+    for (uint8_t col = 0; col < FRAMEBUFFER_COLS; col++) {
+        framebuffer_column(layer, col, 0);
+    }
+}
+
+
+/** Makes a layer hold a single lit pixel, e.g. the ball.
+    @param layer Layer to draw on
+    @param col Display column
+    @param row Display row */
+void framebuffer_place(Layer layer, uint8_t col, uint8_t row)
+{
+    for (uint8_t i = 0; i < FRAMEBUFFER_COLS; i++) {
+        framebuffer_column(layer, i, i == col ? (column_t)1 << row : 0);
+    }
+}
+
+
+/** Copies a whole bitmap kept in program memory onto a layer.
+    @param layer Layer to draw on
+    @param bitmap One pattern per column, in program memory */
+void framebuffer_blit_P(Layer layer, const column_t bitmap[FRAMEBUFFER_COLS])
+{
+    for (uint8_t col = 0; col < FRAMEBUFFER_COLS; col++) {
+        framebuffer_column(layer, col, pgm_read_column(&bitmap[col]));
+    }
+}
+
+
+/** Chooses which layers are shown. Hidden layers keep their pixels.
+    @param mask Bit n set to show layer n, FRAMEBUFFER_ALL_LAYERS for all */
+void framebuffer_show(uint8_t mask)
+{
+    if (mask != shown) {
+        shown = mask;
+        dirty = (Column_Mask)((1UL << FRAMEBUFFER_COLS) - 1);
+    }
+}
+
+
+/** Drives the next column of the LED matrix. Call at the display refresh rate. */
+void framebuffer_scan(void)
+{
+    if (dirty & ((Column_Mask)1 << scan_col)) {
+        column_t pattern = 0;
+        for (uint8_t layer = 0; layer < LAYER_COUNT; layer++) {
+            if (shown & (1 << layer)) {
+                pattern |= layers[layer][scan_col];
+            }
+        }
+        screen[scan_col] = pattern;
+        dirty &= ~((Column_Mask)1 << scan_col);
+    }
+    ledmat_display_column(screen[scan_col], scan_col);
+
+    scan_col++;
+    if (scan_col >= FRAMEBUFFER_COLS) {
+        scan_col = 0;
+    }
+}
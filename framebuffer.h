@@ -0,0 +1,73 @@
+/** @file framebuffer.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Layered framebuffer with a single column scan.
+
+    Every game drawing call writes into one of a few layers, each a bitmap
+    the size of the display in geometry.h (5x7 on the UCFK4), stored as one
+    column_t per column. framebuffer_scan() drives one
+    LED matrix column per call. A column is only recombined from its layers
+    when a write has actually changed it, so redrawing an unmoved paddle
+    or ball every frame costs nothing on the scan side.
+    Co-ordinates are display columns and rows, as for ledmat.
+*/
+
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <stdint.h>
+#include "system.h"
+#include "geometry.h"
+
+#define FRAMEBUFFER_COLS GEOMETRY_COLS
+#define FRAMEBUFFER_ROWS GEOMETRY_ROWS
+
+//Defines the drawing layers. Lit pixels of all shown layers are shown.
+typedef enum {
+    LAYER_COURT,
+    LAYER_BALL,
+    LAYER_OVERLAY,
+    LAYER_COUNT
+} Layer;
+
+#define FRAMEBUFFER_ALL_LAYERS ((1 << LAYER_COUNT) - 1)
+
+
+/** Clears every layer and restarts the scan at the first column. */
+void framebuffer_init(void);
+
+
+/** Sets the pixels of one column of a layer.
+    @param layer Layer to draw on
+    @param col Display column
+    @param pattern Bitmap of the column, bit n is row n */
+void framebuffer_column(Layer layer, uint8_t col, column_t pattern);
+
+
+/** Clears a layer.
+    @param layer Layer to clear */
+void framebuffer_clear(Layer layer);
+
+
+/** Makes a layer hold a single lit pixel, e.g. the ball.
+    @param layer Layer to draw on
+    @param col Display column
+    @param row Display row */
+void framebuffer_place(Layer layer, uint8_t col, uint8_t row);
+
+
+/** Copies a whole bitmap kept in program memory onto a layer.
+    @param layer Layer to draw on
+    @param bitmap One pattern per column, in program memory */
+void framebuffer_blit_P(Layer layer, const column_t bitmap[FRAMEBUFFER_COLS]);
+
+
+/** Chooses which layers are shown. Hidden layers keep their pixels.
+    @param mask Bit n set to show layer n, FRAMEBUFFER_ALL_LAYERS for all */
+void framebuffer_show(uint8_t mask);
+
+
+/** Drives the next column of the LED matrix. Call at the display refresh rate. */
+void framebuffer_scan(void);
+
+#endif //FRAMEBUFFER_H
@@ -5,93 +5,393 @@
 */
 
 #include <stdint.h>
+#include "game.h"
 #include "paddle.h"
-#include "tinygl.h"
 #include "system.h"
 #include "navswitch.h"
 #include "projectile.h"
+#include "balls.h"
+#include "court.h"
 #include "pacer.h"
+#include "task.h"
+#include "timer.h"
 #include <avr/io.h>
 #include "ledmat.h"
-#include "../fonts/font5x7_1.h"
 #include "states.h"
 #include "ir_transmission.h"
-#include "ir_serial.h"
-
-#define PACER_RATE 500
-#define UPDATE_RATE 800
-#define BALL_START_POS {3, 3, 0, 1}
+#include "link.h"
+#include "packet.h"
+#include "framebuffer.h"
+#include "anim.h"
+#include "assets.h"
+#include "text.h"
+#include "input.h"
+#include "profile.h"
+#include "matchlog.h"
+#include "score.h"
+#include "trace.h"
+#ifdef RECORD
+#include "recorder.h"
+#endif
 
 /** Initialises all modules */
 void game_init(void)
 {
     system_init ();
-    tinygl_init(PACER_RATE);
-    pacer_init(PACER_RATE);
-    navswitch_init();
+    text_init(DISPLAY_TASK_RATE);
+    pacer_init(DISPLAY_TASK_RATE);
+    input_init();
     ledmat_init();
-    ir_serial_init();
+    framebuffer_init();
+    link_init();
+#ifdef PROFILE
+    profile_init();
+#endif
+#ifdef TRACE
+    trace_init();
+#endif
 }
 
-/** Chooses action depending on game state
-    @param state Current game state
-    @param projectile Projectile to initialise/write data to
-    @param paddle Paddle object to allow for updates during wait state */
-void game_state(State* state, Projectile* projectile, Paddle* paddle)
+/** Starts a match, and saves it so it can be resumed after a reset.
+    @param game Game whose mode and level are played
+    @param serving 1 if this board serves first */
+static void start_match(Game* game, bool serving)
 {
-    Start_Position position;
-    switch (*state) {
-        //Use paper, scissors, rock to determine starting player
+    game->match.in_match = 1;
+    game->match.serving = serving;
+    game->match.mode = game->mode;
+    game->match.level = game->level;
+    game->match.lost = 0;
+    game->match.won = 0;
+    game->last_point.unsent = 0;
+    game->rally_hits = 0;
+    matchlog_save(&game->match);
+}
+
+/** Saves the match after its score has changed, keeping the longest rally.
+    @param game Game whose match is saved */
+static void save_match(Game* game)
+{
+    if (game->rally_hits > game->match.longest) {
+        game->match.longest = game->rally_hits;
+    }
+    game->rally_hits = 0;
+    matchlog_save(&game->match);
+}
+
+/** Keeps the score when the opponent misses, as score_keep() does, and
+    saves the match when it changes. Two player modes only.
+    @param game Game whose match is kept */
+static void keep_score(Game* game)
+{
+    if (game->mode != MODE_ONE_PLAYER
+        && score_keep(&game->match, &game->last_point, &game->state, &game->balls, &game->court,
+                      game->level, &game->transport, &game->pairing)) {
+        save_match(game);
+    }
+}
+
+/** Carries on the match saved in EEPROM, if there is one. One player
+    matches resume at once; two player matches first ask the opponent.
+    @param game Game to resume into */
+static void resume_saved_match(Game* game)
+{
+    if (!matchlog_load(&game->match) || !game->match.in_match || game->match.mode >= MODE_COUNT) {
+        return;
+    }
+    game->mode = game->match.mode;
+    game->level = game->match.level < LEVEL_COUNT ? game->match.level : LEVEL_OPEN;
+    court_load(&game->court, game->level);
+    if (game->mode == MODE_ONE_PLAYER) {
+        ai_init(&game->ai, AI_DEFAULT_SKILL, timer_get());
+        if (!game->match.serving) {
+            ai_serve(&game->ai);
+        }
+        game->state = game->match.serving ? BALL_SELECT : WAITING;
+    } else {
+        framebuffer_show(1 << LAYER_OVERLAY);
+        text_scroll_P(text_RESUME);
+        game->state = RESUME;
+    }
+}
+
+/** Does one tick of work for the current game state. Never waits, so the
+    other tasks keep running whichever screen is shown.
+    @param game Game whose state, balls and transport are used */
+void game_state(Game* game)
+{
+    //Acknowledges and retransmits whatever the state, so the other board never stalls
+    if (game->mode != MODE_ONE_PLAYER) {
+        transport_poll(&game->transport);
+    }
+
+    switch (game->state) {
+        //Prompts both players to push before the handshake
         case BEGIN:
-            press_to_start();
-            pacer_wait();
-            starting_player_select(state);
+        case PRESS_TO_START:
+            press_to_start(&game->state);
             break;
-        
-        //Starting player selects ball position
-        case BALL_SELECT:
-            position = choose_start(state);
-            *projectile = projectile_init(position);
+
+        //Asks the opponent to carry on the saved match, unless the player pushes
+        case RESUME:
+            resume_match(&game->transport, &game->match, &game->resume_at, &game->state);
+            if (game->state == BEGIN) {
+                game->match.in_match = 0;
+                matchlog_save(&game->match);
+            }
             break;
 
-        //If opponent has ball, wait for ball
-        case WAITING:
-            wait_for_data(projectile, paddle, state);
+        //Chooses IR against another board, or the AI
+        case MODE_SELECT:
+            select_mode(&game->state, &game->mode);
+            break;
+
+        //Chooses the obstacles on this court
+        case LEVEL_SELECT:
+            select_level(&game->state, &game->level, &game->court, game->mode);
+            if (game->state == BALL_SELECT) {
+                ai_init(&game->ai, AI_DEFAULT_SKILL, timer_get());
+                start_match(game, 1);
+            } else if (game->state == PAIRING) {
+                game->handshake = (PSR_Handshake){0};
+                start_pairing(&game->pairing, &game->transport, timer_get());
+            }
             break;
 
+        //Decides who serves by itself, unless either player asks for paper, scissors, rock
+        case PAIRING:
+            auto_pair(&game->pairing, &game->handshake, &game->transport, &game->state);
+            if (game->state == BALL_SELECT || game->state == WAITING) {
+                start_match(game, game->state == BALL_SELECT);
+            }
+            break;
+
+        //Use paper, scissors, rock to determine starting player
+        case PSR_SELECT:
+            select_PSR(&game->handshake, &game->transport, &game->state);
+            break;
+
+        case PSR_READY:
+        case PSR_RESULT:
+            starting_player_select(&game->handshake, &game->transport, &game->state);
+            if (game->state == BALL_SELECT || game->state == WAITING) {
+                start_match(game, game->state == BALL_SELECT);
+            }
+            break;
+
+        //Starting player selects ball position. Balls the opponent was
+        //still playing when this board missed are dropped
+        case BALL_SELECT:
+            keep_score(game);
+            drop_projectiles(&game->transport);
+            if (choose_start(&game->serve, &game->state)) {
+                ball_pool_serve(&game->balls, game->serve,
+                                game->mode == MODE_MULTI_BALL ? MULTI_BALL_COUNT : 1);
+                game->serve = DEFAULT_SERVE;
+            }
+            break;
+
+        //Takes in any balls that have arrived from the opponent.
+        //The AI's court is stepped by the ball task instead
+        case WAITING:
         case GAME_ON:
+            keep_score(game);
+            if (game->mode != MODE_ONE_PLAYER) {
+                wait_for_data(&game->transport, &game->balls, &game->state);
+            }
             break;
     }
 }
 
+/** Runs the game state machine
+    @param data Address of the Game object */
+static void state_task(void* data)
+{
+    Game* game = data;
+    timer_tick_t start = timer_get();
+    State was = game->state;
+    PROFILE_START(PROFILE_STATE);
+    game_state(game);
+    PROFILE_END(PROFILE_STATE);
+    if (game->state != was) {
+        TRACE_EVENT(TRACE_STATE, game->state);
+    }
+    game->busy_ticks += timer_get() - start;
+}
+
+/** Polls the navswitch, and moves the paddle on the presses just taken,
+    unless the navswitch is being used for a menu. In PROFILE builds,
+    pushing west shows the stage timings.
+    @param data Address of the Game object */
+static void input_task(void* data)
+{
+    Game* game = data;
+    timer_tick_t start = timer_get();
+    PROFILE_START(PROFILE_INPUT);
+    input_update();
+    PROFILE_END(PROFILE_INPUT);
+    if (state_paddle_free_p(game->state)) {
+        PROFILE_START(PROFILE_PADDLE);
+        update_paddle(&game->paddle, start);
+        PROFILE_END(PROFILE_PADDLE);
+    }
+#ifdef PROFILE
+    if (input_push_event_p(NAVSWITCH_WEST)) {
+        profile_show();
+    }
+#endif
+    game->busy_ticks += timer_get() - start;
+}
+
+/** Steps every ball by its sub-pixel velocity, and the AI's court in
+    single-player games
+    @param data Address of the Game object */
+static void ball_task(void* data)
+{
+    Game* game = data;
+    timer_tick_t start = timer_get();
+    State was = game->state;
+    Projectile ball;
+    if (game->state == GAME_ON) {
+        PROFILE_START(PROFILE_BALL);
+        Ball_Events events = ball_pool_step(&game->balls, &game->paddle, &game->court);
+        PROFILE_END(PROFILE_BALL);
+        game->rally_hits += __builtin_popcount(events.returned);
+        if (events.returned) {
+            TRACE_EVENT(TRACE_HIT, TRACE_PADDLE(events.returned, get_paddle_bottom(&game->paddle)));
+        }
+        if (events.missed) {
+            TRACE_EVENT(TRACE_MISS, TRACE_PADDLE(events.missed, get_paddle_bottom(&game->paddle)));
+            //The first ball missed loses the point, and the bricks come back
+            score_miss(&game->match, &game->last_point, &game->state, &game->balls, &game->court, game->level,
+                       game->mode == MODE_ONE_PLAYER ? NULL : &game->transport);
+            save_match(game);
+            anim_play(&animation_LOSE);
+        } else {
+            for (uint8_t id = 0; events.crossed; id++, events.crossed >>= 1) {
+                if (!(events.crossed & 1)) {
+                    continue;
+                }
+                ball_pool_get(&game->balls, id, &ball);
+                if (game->mode == MODE_ONE_PLAYER) {
+                    turn_projectile(&ball);
+                    ai_receive(&game->ai, &ball);
+                } else {
+                    send_projectile(&game->transport, &ball, id);
+                }
+            }
+            if (!game->balls.live) {
+                game->state = WAITING;
+            }
+        }
+    } else if (game->state == WAITING && game->mode == MODE_ONE_PLAYER) {
+        switch (ai_step(&game->ai, &ball)) {
+            case AI_RETURNED:
+                ball_pool_put(&game->balls, 0, &ball);
+                game->state = GAME_ON;
+                break;
+            case AI_MISSED:
+                game->match.won++;
+                score_end_point(&game->match, &game->last_point, 0);
+                save_match(game);
+                anim_play(&animation_WIN);
+                break;
+            case AI_BUSY:
+                break;
+        }
+    }
+    if (game->state != was) {
+        TRACE_EVENT(TRACE_STATE, game->state);
+    }
+    game->busy_ticks += timer_get() - start;
+}
+
+/** Moves the playing animation on by one frame tick
+    @param data Address of the Game object */
+static void anim_task(void* data)
+{
+    Game* game = data;
+    timer_tick_t start = timer_get();
+    anim_step();
+    game->busy_ticks += timer_get() - start;
+}
+
+/** Redraws the court, paddle, balls and text and refreshes one display column
+    @param data Address of the Game object */
+static void display_task(void* data)
+{
+    Game* game = data;
+    timer_tick_t start = timer_get();
+    PROFILE_START(PROFILE_DRAW);
+    court_draw(&game->court);
+    display_paddle(&game->paddle);
+    ball_pool_draw(&game->balls);
+    text_update();
+    PROFILE_END(PROFILE_DRAW);
+    PROFILE_START(PROFILE_SCAN);
+    framebuffer_scan();
+    PROFILE_END(PROFILE_SCAN);
+    game->busy_ticks += timer_get() - start;
+}
+
+/** Works out how much of the last window was spent in tasks.
+    100 - load is the headroom left for new work.
+    @param data Address of the Game object */
+static void load_task(void* data)
+{
+    Game* game = data;
+    game->load = (uint32_t)game->busy_ticks * 100 * LOAD_TASK_RATE / TASK_RATE;
+    game->busy_ticks = 0;
+    PROFILE_LOAD(game->load);
+}
+
+/** Writes the saved match to EEPROM, a byte at a time
+    @param data Address of the Game object */
+static void save_task(void* data)
+{
+    Game* game = data;
+    timer_tick_t start = timer_get();
+    matchlog_drain();
+    game->busy_ticks += timer_get() - start;
+}
+
+#ifdef RECORD
+/** Copies the input recording into EEPROM, a byte at a time
+    @param data Address of the Game object */
+static void record_task(void* data)
+{
+    Game* game = data;
+    timer_tick_t start = timer_get();
+    recorder_drain();
+    game->busy_ticks += timer_get() - start;
+}
+#endif
+
 int main (void)
 {
     //intialise modules and game variables
+    static Game game = {.state = BEGIN, .serve = DEFAULT_SERVE, .pairing = {.opponent = PACKET_PAIR_NONE}};
+    task_t tasks[] =
+    {
+        {.func = display_task, .data = &game, .period = TASK_RATE / DISPLAY_TASK_RATE},
+        {.func = input_task, .data = &game, .period = TASK_RATE / INPUT_TASK_RATE},
+        {.func = state_task, .data = &game, .period = TASK_RATE / STATE_TASK_RATE},
+        {.func = ball_task, .data = &game, .period = TASK_RATE / BALL_TASK_RATE},
+        {.func = anim_task, .data = &game, .period = TASK_RATE / ANIM_TASK_RATE},
+        {.func = load_task, .data = &game, .period = TASK_RATE / LOAD_TASK_RATE},
+        {.func = save_task, .data = &game, .period = TASK_RATE / SAVE_TASK_RATE},
+#ifdef RECORD
+        {.func = record_task, .data = &game, .period = TASK_RATE / RECORD_TASK_RATE},
+#endif
+    };
+
     game_init();
-    State state = BEGIN;
-    Paddle paddle = init_paddle();
-    Projectile projectile = BALL_START_POS;
-    uint16_t update_counter = 0;
-
-    while (1)
-    {   
-        //Chooses what to do depending on game state
-        game_state(&state, &projectile, &paddle);
-
-        tinygl_clear();
-        navswitch_update();
-
-        /*update paddle and paddle display*/
-        display_paddle(&paddle);
-        update_paddle(&paddle);
-        draw_projectile(&projectile);
-        tinygl_update();
-
-        /*Updates projectile every so often. When going straight
-             updates 2x as fast as projectile is 2x as slow*/
-        if ((update_counter % UPDATE_RATE == 0 || (update_counter % UPDATE_RATE/2 == 0 && projectile.delta_x == 0))) {
-            update_pos(&projectile, &paddle, &state);
-        } 
-        update_counter++;
-    } 
+    game.paddle = init_paddle();
+    court_load(&game.court, LEVEL_OPEN);
+    resume_saved_match(&game);
+    transport_reset(&game.transport);
+    TRACE_EVENT(TRACE_STATE, game.state);
+
+    task_schedule(tasks, sizeof(tasks) / sizeof(tasks[0]));
+    return 0;
 }
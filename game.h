@@ -0,0 +1,69 @@
+/** @file game.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Main game file for tennis!
+
+    The game runs as a set of tasks on the UCFK4 task scheduler, each at
+    its own fixed rate, so game speed does not depend on how long drawing
+    takes. Rates are in Hz and can be tuned independently.
+*/
+
+#ifndef GAME_H
+#define GAME_H
+
+#include <stdint.h>
+#include "system.h"
+#include "task.h"
+#include "timer.h"
+#include "paddle.h"
+#include "projectile.h"
+#include "balls.h"
+#include "court.h"
+#include "packet.h"
+#include "transport.h"
+#include "states.h"
+#include "ir_transmission.h"
+#include "anim.h"
+#include "ai.h"
+#include "matchlog.h"
+#include "score.h"
+
+/*Task rates in Hz. The ball moves by its Q8.8 velocity on every ball step,
+    so ball speed in cells per second is BALL_TASK_RATE times that velocity.
+    The state task also polls the IR transport in every state, so it runs
+    fast enough to catch the start of each IR byte and time its arrival.
+    The record task only runs in RECORD builds; EEPROM takes about 3.3 ms
+    to write each byte, so the save task writes the match log no faster.
+    The animation task runs once per animation tick. The paddle moves
+    from the input task, on the presses each poll takes*/
+#define DISPLAY_TASK_RATE 500
+#define INPUT_TASK_RATE 100
+#define STATE_TASK_RATE 2000
+#define BALL_TASK_RATE 50
+#define LOAD_TASK_RATE 1
+#define RECORD_TASK_RATE 250
+#define SAVE_TASK_RATE 250
+#define ANIM_TASK_RATE (1000 / ANIM_TICK_MS)
+
+//Defines everything the game tasks share
+typedef struct {
+    State state;
+    Paddle paddle;
+    Ball_Pool balls;          //balls in play on this court
+    Court_Map court;          //obstacles left on this court
+    Level level;              //obstacles the court is reset to after each point
+    Pairing pairing;          //nonces exchanged while PAIRING
+    PSR_Handshake handshake;  //paper, scissors, rock choices while PSR_*
+    Start_Position serve;     //heading being chosen in BALL_SELECT
+    Game_Mode mode;
+    Ai ai;
+    Transport transport;      //reliable IR link to the other board
+    Match_Record match;       //score and stats, saved to EEPROM after every point
+    uint8_t rally_hits;       //returns by this board in the point being played
+    Last_Point last_point;    //point last ended, and whether this board's miss is sent
+    timer_tick_t resume_at;   //timer tick to ask the opponent to resume again
+    timer_tick_t busy_ticks;  //timer ticks spent in tasks this load window
+    uint8_t load;             //percent of the last load window spent in tasks
+} Game;
+
+#endif //GAME_H
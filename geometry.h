@@ -0,0 +1,85 @@
+/** @file geometry.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Size and orientation of the court and display, fixed at build time.
+
+    The court is COURT_WIDTH cells across, the way the paddle moves, and
+    COURT_DEPTH cells from the paddle to the edge balls cross to the other
+    board. Each court row is one display column and each court column one
+    display row, so the display is COURT_DEPTH columns of COURT_WIDTH rows.
+    COURT_FLIP_X and COURT_FLIP_Y mirror the court on the display; the
+    UCFK4 has the paddle on the last column and court column 0 on the
+    bottom row. Every bound and transform here is a constant expression,
+    so it folds into the code that uses it.
+
+    COURT_GEOMETRY picks the geometry, e.g. make GEOMETRY=8X8. Larger
+    matrices run on the host, or on a board whose LED matrix driver
+    matches; the 5x7 bitmaps and font are drawn in their top left corner.
+*/
+
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include <stdint.h>
+
+//Geometries that can be built
+#define GEOMETRY_UCFK4 0
+#define GEOMETRY_8X8 1
+#define GEOMETRY_16X16 2
+
+#ifndef COURT_GEOMETRY
+#define COURT_GEOMETRY GEOMETRY_UCFK4
+#endif
+
+#if COURT_GEOMETRY == GEOMETRY_UCFK4
+#define COURT_WIDTH 7
+#define COURT_DEPTH 5
+#define PADDLE_LENGTH 3
+#elif COURT_GEOMETRY == GEOMETRY_8X8
+#define COURT_WIDTH 8
+#define COURT_DEPTH 8
+#define PADDLE_LENGTH 3
+#elif COURT_GEOMETRY == GEOMETRY_16X16
+#define COURT_WIDTH 16
+#define COURT_DEPTH 16
+#define PADDLE_LENGTH 5
+#else
+#error "unknown COURT_GEOMETRY"
+#endif
+
+#ifndef COURT_FLIP_X
+#define COURT_FLIP_X 1
+#endif
+#ifndef COURT_FLIP_Y
+#define COURT_FLIP_Y 1
+#endif
+
+#if COURT_WIDTH > 16 || COURT_WIDTH < 7 || COURT_DEPTH < 5
+#error "the display must fit the 5x7 bitmaps and font, and a court row 16 bits"
+#endif
+#if PADDLE_LENGTH % 2 == 0 || PADDLE_LENGTH > COURT_WIDTH
+#error "the paddle needs a middle cell, and must fit across the court"
+#endif
+
+//Court bounds in cells
+#define COURT_MAX_X (COURT_WIDTH - 1)
+#define COURT_MAX_Y (COURT_DEPTH - 1)
+
+//Display size
+#define GEOMETRY_COLS COURT_DEPTH
+#define GEOMETRY_ROWS COURT_WIDTH
+
+/** Display row of court column x. */
+#define COURT_ROW(x) (COURT_FLIP_X ? COURT_MAX_X - (x) : (x))
+
+/** Display column of court row y. */
+#define COURT_COL(y) (COURT_FLIP_Y ? COURT_MAX_Y - (y) : (y))
+
+//Defines the pixels of one display column, bit n is row n
+#if GEOMETRY_ROWS <= 8
+typedef uint8_t column_t;
+#else
+typedef uint16_t column_t;
+#endif
+
+#endif //GEOMETRY_H
@@ -0,0 +1,320 @@
+/** @file hw_shim.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Thin hardware shim for the native (host) build.
+*/
+
+#include <string.h>
+#include "system.h"
+#include "ledmat.h"
+#include "nav_events.h"
+#include "pacer.h"
+#include "ir_serial.h"
+#include "timer.h"
+#include "task.h"
+#include "hw_shim.h"
+#include <avr/eeprom.h>
+
+/** Court that the driver calls act on. One per thread. */
+static _Thread_local Court_IO* court;
+
+/** EEPROM behind <avr/eeprom.h>. */
+uint8_t hw_shim_eeprom[E2END + 1];
+
+
+/** Empties a link, clears its faults and zeroes its counts.
+    @param link Address of the Link object. */
+void link_reset(Link* link)
+{
+    link->head = 0;
+    link->tail = 0;
+    link->busy_until = 0;
+    link->faults = (Link_Faults){0};
+    link->seed = 1;
+    link->sent = 0;
+    link->dropped = 0;
+    link->flipped = 0;
+    link->reordered = 0;
+}
+
+
+/** Gives a link faults to inject from now on.
+    @param link Address of the Link object.
+    @param faults Faults to inject
+    @param seed Seed the faults are drawn from, must not be 0 */
+void link_set_faults(Link* link, const Link_Faults* faults, uint32_t seed)
+{
+    link->faults = *faults;
+    link->seed = seed ? seed : 1;
+}
+
+
+/** Returns the next number from a link's xorshift generator.
+    @param link Address of the Link object.
+    @return pseudo-random 32-bit number */
+static uint32_t link_random(Link* link)
+{
+    uint32_t x = link->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    link->seed = x;
+    return x;
+}
+
+
+/** Rolls for a fault on a link.
+    @param link Address of the Link object.
+    @param chance Chance of the fault, out of LINK_CHANCE_SCALE
+    @return 1 if the fault happens */
+static bool link_roll(Link* link, uint16_t chance)
+{
+    return chance && link_random(link) % LINK_CHANCE_SCALE < chance;
+}
+
+
+/** Returns the number of bytes in flight or waiting on a link.
+    @param link Address of the Link object.
+    @return bytes not yet taken by ir_serial_receive(). */
+uint8_t link_pending(const Link* link)
+{
+    return (uint8_t)(link->head - link->tail) % LINK_BUFFER_SIZE;
+}
+
+
+/** Returns when the next byte on a link arrives.
+    @param link Address of the Link object, with a byte pending.
+    @return timer tick of the arrival. */
+timer_tick_t link_next_arrival(const Link* link)
+{
+    return link->arrival[link->tail];
+}
+
+
+/** Joins two courts with a pair of empty links, as if the boards
+    were lined up facing each other.
+    @param a First court
+    @param b Second court
+    @param a_to_b Link carrying bytes from a to b
+    @param b_to_a Link carrying bytes from b to a
+    @param byte_ticks Airtime of one byte on either link */
+void hw_shim_connect(Court_IO* a, Court_IO* b, Link* a_to_b, Link* b_to_a, timer_tick_t byte_ticks)
+{
+    memset(a, 0, sizeof(*a));
+    memset(b, 0, sizeof(*b));
+    link_reset(a_to_b);
+    link_reset(b_to_a);
+    a_to_b->byte_ticks = byte_ticks;
+    b_to_a->byte_ticks = byte_ticks;
+    a->tx = a_to_b;
+    a->rx = b_to_a;
+    b->tx = b_to_a;
+    b->rx = a_to_b;
+}
+
+
+/** Selects the court that the driver calls act on for this thread.
+    @param selected Address of the Court_IO object. */
+void hw_shim_select(Court_IO* selected)
+{
+    court = selected;
+}
+
+
+/** Presses or releases a navswitch button on the selected court.
+    The edge is reported by the next navswitch_update().
+    @param button NAVSWITCH_NORTH, ..., NAVSWITCH_PUSH
+    @param down 1 to press, 0 to release */
+void hw_shim_navswitch_set(uint8_t button, bool down)
+{
+    uint8_t mask = 1 << button;
+    uint8_t next = (court->nav_head + 1) % NAV_EVENTS_SIZE;
+    if (!!(court->navswitch_down & mask) == down || next == court->nav_tail) {
+        return;
+    }
+    court->navswitch_down ^= mask;
+    court->nav_events[court->nav_head].button = button;
+    court->nav_events[court->nav_head].pressed = down;
+    court->nav_events[court->nav_head].time = (uint32_t)court->now * NAV_SAMPLE_RATE / TIMER_RATE;
+    court->nav_head = next;
+}
+
+
+/** Queues a byte on the selected court's receive link, ready to be
+    taken by the next ir_serial_receive().
+    @param data Byte to receive */
+void hw_shim_ir_inject(uint8_t data)
+{
+    Link* link = court->rx;
+    if (link_pending(link) == LINK_BUFFER_SIZE - 1) {
+        return;
+    }
+    link->data[link->head] = data;
+    link->arrival[link->head] = court->now;
+    link->head = (link->head + 1) % LINK_BUFFER_SIZE;
+}
+
+
+/** Calls the selected court's poll hook, if it has one. */
+static void hw_shim_poll(void)
+{
+    if (court->poll) {
+        court->poll(court);
+    }
+}
+
+
+/* System, timer, pacer, scheduler and LED matrix */
+
+void system_init(void)
+{
+}
+
+void timer_init(void)
+{
+}
+
+timer_tick_t timer_get(void)
+{
+    return court->now;
+}
+
+timer_tick_t timer_wait_until(timer_tick_t when)
+{
+    court->now = when;
+    return when;
+}
+
+void pacer_init(pacer_rate_t pacer_rate)
+{
+    court->pacer_period = TIMER_RATE / pacer_rate;
+}
+
+void pacer_wait(void)
+{
+    court->now += court->pacer_period;
+}
+
+void task_schedule(task_t* tasks, uint8_t num_tasks)
+{
+    for (uint8_t i = 0; i < num_tasks; i++) {
+        tasks[i].reschedule = court->now;
+    }
+
+    //Runs every task that is due, then jumps to the next one due
+    while (1) {
+        timer_tick_t wait = ~0;
+        for (uint8_t i = 0; i < num_tasks; i++) {
+            if ((int16_t)(tasks[i].reschedule - court->now) <= 0) {
+                tasks[i].func(tasks[i].data);
+                tasks[i].reschedule += tasks[i].period;
+            }
+        }
+        for (uint8_t i = 0; i < num_tasks; i++) {
+            int16_t due = tasks[i].reschedule - court->now;
+            if (due <= 0) {
+                wait = 0;
+            } else if ((timer_tick_t)due < wait) {
+                wait = due;
+            }
+        }
+        court->now += wait;
+    }
+}
+
+void ledmat_init(void)
+{
+}
+
+void ledmat_display_column(column_t pattern, uint8_t col)
+{
+    if (col < LEDMAT_COLS_NUM) {
+        court->columns[col] = pattern;
+        if (court->shown) {
+            court->shown(court, col);
+        }
+    }
+}
+
+
+/* Navswitch events, queued without debouncing */
+
+void nav_events_init(void)
+{
+    court->nav_head = 0;
+    court->nav_tail = 0;
+}
+
+uint8_t nav_events_take(Nav_Event* events, uint8_t size)
+{
+    uint8_t count = 0;
+    hw_shim_poll();
+    court->nav_polled = court->now;
+    while (count < size && court->nav_tail != court->nav_head) {
+        events[count++] = court->nav_events[court->nav_tail];
+        court->nav_tail = (court->nav_tail + 1) % NAV_EVENTS_SIZE;
+    }
+    return count;
+}
+
+uint8_t nav_events_dropped(void)
+{
+    return 0;
+}
+
+
+/* IR serial, over the court's in-memory links */
+
+void ir_serial_init(void)
+{
+}
+
+void ir_serial_transmit(uint8_t data)
+{
+    Link* link = court->tx;
+    if (link_pending(link) == LINK_BUFFER_SIZE - 1) {
+        return; //receiver overrun, byte lost as it would be over IR
+    }
+    //Bytes go out back to back, each after the one before has finished
+    if ((int16_t)(link->busy_until - court->now) < 0) {
+        link->busy_until = court->now;
+    }
+    link->busy_until += link->byte_ticks;
+    link->sent++;
+
+    //A lost byte still took its airtime
+    if (link_roll(link, link->faults.drop)) {
+        link->dropped++;
+        return;
+    }
+    if (link_roll(link, link->faults.flip)) {
+        data ^= 1 << (link_random(link) % 8);
+        link->flipped++;
+    }
+    link->data[link->head] = data;
+    link->arrival[link->head] = link->busy_until + link->faults.latency;
+    if (link->faults.jitter) {
+        link->arrival[link->head] += link_random(link) % (link->faults.jitter + 1);
+    }
+
+    //Overtakes the byte before, if that has not been received yet
+    if (link_pending(link) > 0 && link_roll(link, link->faults.reorder)) {
+        uint8_t before = (link->head + LINK_BUFFER_SIZE - 1) % LINK_BUFFER_SIZE;
+        link->data[link->head] = link->data[before];
+        link->data[before] = data;
+        link->reordered++;
+    }
+    link->head = (link->head + 1) % LINK_BUFFER_SIZE;
+}
+
+ir_serial_ret_t ir_serial_receive(uint8_t* pdata)
+{
+    hw_shim_poll();
+    Link* link = court->rx;
+    if (link_pending(link) == 0 || (int16_t)(link_next_arrival(link) - court->now) > 0) {
+        return IR_SERIAL_NONE;
+    }
+    *pdata = link->data[link->tail];
+    link->tail = (link->tail + 1) % LINK_BUFFER_SIZE;
+    return IR_SERIAL_OK;
+}
@@ -0,0 +1,126 @@
+/** @file hw_shim.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Thin hardware shim for the native (host) build.
+
+    Stands in for ledmat, nav_events, timer, task, pacer and ir_serial so the
+    game modules can run unmodified on a PC. Every driver call acts on
+    the court selected with hw_shim_select(). The selection is per
+    thread, so each thread can run its own pair of courts.
+
+    Time is virtual: the timer only moves when the task scheduler or the
+    pacer waits, so a run depends on nothing but its inputs. A court can
+    set a poll hook, called whenever the game polls the navswitch or the
+    IR receiver, to feed it input at an exact poll, and a display hook,
+    called as each column is driven, to see exactly when a pixel changes.
+
+    Each link is a loopback stand-in for IR that can be given faults:
+    latency, jitter, lost bytes, bit flips and reordering. Faults are
+    drawn from the link's own seed, so they repeat exactly.
+*/
+
+#ifndef HW_SHIM_H
+#define HW_SHIM_H
+
+#include "system.h"
+#include "timer.h"
+#include "nav_events.h"
+
+#define LINK_BUFFER_SIZE 64
+#define LINK_CHANCE_SCALE 10000  //fault chances are out of this
+
+//Defines the faults a link injects into the bytes sent over it
+typedef struct {
+    timer_tick_t latency;  //ticks added to the arrival of every byte
+    timer_tick_t jitter;   //up to this many more ticks, at random
+    uint16_t drop;         //chance that a byte is lost
+    uint16_t flip;         //chance that one bit of a byte is flipped
+    uint16_t reorder;      //chance that a byte overtakes the one before
+} Link_Faults;
+
+//Defines one direction of the IR link as a byte ring buffer
+typedef struct {
+    uint8_t data[LINK_BUFFER_SIZE];
+    timer_tick_t arrival[LINK_BUFFER_SIZE];
+    uint8_t head;
+    uint8_t tail;
+    timer_tick_t byte_ticks;  //airtime of one byte
+    timer_tick_t busy_until;  //when the last byte queued finishes arriving
+    Link_Faults faults;
+    uint32_t seed;
+    uint32_t sent;            //bytes sent, and how many of them were hit by each fault
+    uint32_t dropped;
+    uint32_t flipped;
+    uint32_t reordered;
+} Link;
+
+//Defines the hardware seen by one board
+typedef struct Court_IO Court_IO;
+struct Court_IO {
+    Link* rx;
+    Link* tx;
+    uint8_t navswitch_down;
+    Nav_Event nav_events[NAV_EVENTS_SIZE];
+    uint8_t nav_head;
+    uint8_t nav_tail;
+    column_t columns[LEDMAT_COLS_NUM];
+    timer_tick_t now;
+    timer_tick_t pacer_period;     //timer ticks between pacer_wait() returns
+    timer_tick_t nav_polled;       //when the game last took navswitch events
+    void (*poll)(Court_IO* court); //called before each input poll, or NULL
+    void (*shown)(Court_IO* court, uint8_t col); //called after each column is driven, or NULL
+};
+
+
+/** Empties a link, clears its faults and zeroes its counts.
+    @param link Address of the Link object. */
+void link_reset(Link* link);
+
+
+/** Gives a link faults to inject from now on.
+    @param link Address of the Link object.
+    @param faults Faults to inject
+    @param seed Seed the faults are drawn from, must not be 0 */
+void link_set_faults(Link* link, const Link_Faults* faults, uint32_t seed);
+
+
+/** Returns the number of bytes in flight or waiting on a link.
+    @param link Address of the Link object.
+    @return bytes not yet taken by ir_serial_receive(). */
+uint8_t link_pending(const Link* link);
+
+
+/** Returns when the next byte on a link arrives.
+    @param link Address of the Link object, with a byte pending.
+    @return timer tick of the arrival. */
+timer_tick_t link_next_arrival(const Link* link);
+
+
+/** Joins two courts with a pair of empty links, as if the boards
+    were lined up facing each other.
+    @param a First court
+    @param b Second court
+    @param a_to_b Link carrying bytes from a to b
+    @param b_to_a Link carrying bytes from b to a
+    @param byte_ticks Airtime of one byte on either link */
+void hw_shim_connect(Court_IO* a, Court_IO* b, Link* a_to_b, Link* b_to_a, timer_tick_t byte_ticks);
+
+
+/** Selects the court that the driver calls act on for this thread.
+    @param court Address of the Court_IO object. */
+void hw_shim_select(Court_IO* court);
+
+
+/** Presses or releases a navswitch button on the selected court.
+    The event is queued at once, as if already debounced.
+    @param button NAVSWITCH_NORTH, ..., NAVSWITCH_PUSH
+    @param down 1 to press, 0 to release */
+void hw_shim_navswitch_set(uint8_t button, bool down);
+
+
+/** Queues a byte on the selected court's receive link, ready to be
+    taken by the next ir_serial_receive().
+    @param data Byte to receive */
+void hw_shim_ir_inject(uint8_t data);
+
+#endif //HW_SHIM_H
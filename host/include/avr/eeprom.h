@@ -0,0 +1,23 @@
+/** @file eeprom.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Host stand-in for <avr/eeprom.h>. EEPROM is an array in
+    hw_shim.c, shared by every thread, which starts out all zeros and is
+    always ready to write.
+*/
+
+#ifndef AVR_EEPROM_H
+#define AVR_EEPROM_H
+
+#include <stdint.h>
+#include <avr/io.h>
+
+extern uint8_t hw_shim_eeprom[E2END + 1];
+
+#define eeprom_is_ready() 1
+
+#define eeprom_read_byte(address) (hw_shim_eeprom[(uintptr_t)(address)])
+
+#define eeprom_write_byte(address, value) (hw_shim_eeprom[(uintptr_t)(address)] = (value))
+
+#endif //AVR_EEPROM_H
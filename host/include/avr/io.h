@@ -0,0 +1,15 @@
+/** @file io.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Host stand-in for <avr/io.h>. Only the memory sizes are needed.
+*/
+
+#ifndef AVR_IO_H
+#define AVR_IO_H
+
+#include <stdint.h>
+
+//Last EEPROM address of the ATmega32u2, which has 1 KB
+#define E2END 0x3FF
+
+#endif //AVR_IO_H
@@ -0,0 +1,21 @@
+/** @file pgmspace.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Host stand-in for <avr/pgmspace.h>. Program memory is ordinary memory.
+*/
+
+#ifndef AVR_PGMSPACE_H
+#define AVR_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+
+#define pgm_read_word(address) (*(const uint16_t*)(address))
+
+#define memcpy_P(destination, source, size) memcpy(destination, source, size)
+
+#endif //AVR_PGMSPACE_H
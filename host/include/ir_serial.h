@@ -0,0 +1,31 @@
+/** @file ir_serial.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Host stand-in for the UCFK4 IR serial driver.
+
+    Bytes travel over the in-memory link of the court selected
+    with hw_shim_select().
+*/
+
+#ifndef IR_SERIAL_H
+#define IR_SERIAL_H
+
+#include "system.h"
+
+typedef enum ir_serial_ret
+{
+    IR_SERIAL_OK = 1,
+    IR_SERIAL_NONE = 0,
+    IR_SERIAL_OVERRUN_ERROR = -1,
+    IR_SERIAL_PARITY_ERROR = -2,
+    IR_SERIAL_START_ERROR = -3,
+    IR_SERIAL_STOP_ERROR = -4
+} ir_serial_ret_t;
+
+void ir_serial_init (void);
+
+void ir_serial_transmit (uint8_t data);
+
+ir_serial_ret_t ir_serial_receive (uint8_t *pdata);
+
+#endif //IR_SERIAL_H
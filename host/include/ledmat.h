@@ -0,0 +1,16 @@
+/** @file ledmat.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Host stand-in for the UCFK4 LED matrix driver.
+*/
+
+#ifndef LEDMAT_H
+#define LEDMAT_H
+
+#include "system.h"
+
+void ledmat_init (void);
+
+void ledmat_display_column (column_t pattern, uint8_t col);
+
+#endif //LEDMAT_H
@@ -0,0 +1,16 @@
+/** @file navswitch.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Host stand-in for the UCFK4 navswitch driver. Only the button
+    names are used; presses come from the shim's nav_events queue.
+*/
+
+#ifndef NAVSWITCH_H
+#define NAVSWITCH_H
+
+#include "system.h"
+
+enum {NAVSWITCH_NORTH, NAVSWITCH_EAST, NAVSWITCH_SOUTH, NAVSWITCH_WEST,
+      NAVSWITCH_PUSH};
+
+#endif //NAVSWITCH_H
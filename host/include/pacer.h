@@ -0,0 +1,18 @@
+/** @file pacer.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Host stand-in for the UCFK4 pacer. Never waits.
+*/
+
+#ifndef PACER_H
+#define PACER_H
+
+#include "system.h"
+
+typedef uint16_t pacer_rate_t;
+
+void pacer_init (pacer_rate_t pacer_rate);
+
+void pacer_wait (void);
+
+#endif //PACER_H
@@ -0,0 +1,25 @@
+/** @file system.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Host stand-in for the UCFK4 system driver.
+
+    Only the parts of the UCFK4 headers that the game modules use
+    are provided, so the game logic can be compiled natively.
+*/
+
+#ifndef SYSTEM_H
+#define SYSTEM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "geometry.h"
+
+#define F_CPU 8000000
+
+//The simulated LED matrix is the size of the court
+#define LEDMAT_ROWS_NUM GEOMETRY_ROWS
+#define LEDMAT_COLS_NUM GEOMETRY_COLS
+
+void system_init (void);
+
+#endif //SYSTEM_H
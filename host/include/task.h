@@ -0,0 +1,27 @@
+/** @file task.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Host stand-in for the UCFK4 task scheduler.
+*/
+
+#ifndef TASK_H
+#define TASK_H
+
+#include "system.h"
+#include "timer.h"
+
+#define TASK_RATE TIMER_RATE
+
+typedef void (* task_func_t)(void *data);
+
+typedef struct task_struct
+{
+    task_func_t func;
+    void *data;
+    timer_tick_t period;
+    timer_tick_t reschedule;
+} task_t;
+
+void task_schedule (task_t *tasks, uint8_t num_tasks);
+
+#endif //TASK_H
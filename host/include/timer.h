@@ -0,0 +1,23 @@
+/** @file timer.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Host stand-in for the UCFK4 timer driver.
+*/
+
+#ifndef TIMER_H
+#define TIMER_H
+
+#include "system.h"
+
+#define TIMER_CLOCK_DIVISOR 1024
+#define TIMER_RATE (F_CPU / TIMER_CLOCK_DIVISOR)
+
+typedef uint16_t timer_tick_t;
+
+void timer_init (void);
+
+timer_tick_t timer_get (void);
+
+timer_tick_t timer_wait_until (timer_tick_t when);
+
+#endif //TIMER_H
@@ -0,0 +1,114 @@
+/** @file link_bench.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Measures the IR protocol on links with injected faults.
+
+    For each fault profile, plays rallies, paper, scissors, rock
+    handshakes and automatic pairings between two simulated boards and
+    reports how long the ball takes to cross between courts, how many
+    frames the transport had to send again, how long each way of deciding
+    who starts takes, and how often any of them stalls for good.
+
+    Usage: link_bench [-n rallies] [-h handshakes] [-s seed]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "task.h"
+#include "hw_shim.h"
+#include "sim.h"
+
+#define DEFAULT_RALLIES 20000
+#define DEFAULT_HANDSHAKES 20000
+#define DEFAULT_SEED 2025
+#define DEFAULT_SKILL 90
+#define DEFAULT_MAX_HITS 100
+#define DEFAULT_LINK_BYTE_TICKS 40
+#define TICKS_TO_MS(ticks) ((ticks) * 1000.0 / TIMER_RATE)
+#define PERCENT(part, whole) ((whole) ? 100.0 * (part) / (whole) : 0.0)
+
+//Defines a named set of link faults
+typedef struct {
+    const char* name;
+    Link_Faults faults;
+} Fault_Profile;
+
+/** Fault profiles, from a clean link to a noisy room. Chances are out of
+    LINK_CHANCE_SCALE, times in timer ticks. */
+static const Fault_Profile profiles[] = {
+    {"clean",      {0}},
+    {"latency",    {.latency = 40}},
+    {"jitter",     {.latency = 20, .jitter = 80}},
+    {"drop 1%",    {.drop = 100}},
+    {"drop 5%",    {.drop = 500}},
+    {"flip 1%",    {.flip = 100}},
+    {"reorder 5%", {.reorder = 500}},
+    {"noisy room", {.latency = 20, .jitter = 40, .drop = 200, .flip = 100, .reorder = 100}},
+};
+
+#define PROFILE_COUNT (sizeof(profiles) / sizeof(profiles[0]))
+
+
+int main(int argc, char** argv)
+{
+    uint64_t rallies = DEFAULT_RALLIES;
+    uint64_t handshakes = DEFAULT_HANDSHAKES;
+    uint32_t seed = DEFAULT_SEED;
+    int option;
+
+    while ((option = getopt(argc, argv, "n:h:s:")) != -1) {
+        switch (option) {
+            case 'n':
+                rallies = strtoull(optarg, NULL, 10);
+                break;
+            case 'h':
+                handshakes = strtoull(optarg, NULL, 10);
+                break;
+            case 's':
+                seed = strtoul(optarg, NULL, 10);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n rallies] [-h handshakes] [-s seed]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (seed == 0) {
+        seed = 1;
+    }
+
+    printf("%-11s  %10s  %9s  %10s  %11s  %12s  %9s  %9s  %10s  %9s  %9s\n", "profile", "handoff ms",
+           "worst ms", "stalls", "resends", "handshake ms", "hs stalls", "hs splits",
+           "pairing ms", "pr stalls", "pr splits");
+    for (uint8_t i = 0; i < PROFILE_COUNT; i++) {
+        Sim_Config config = {POLICY_TRACK, DEFAULT_SKILL, DEFAULT_MAX_HITS, DEFAULT_LINK_BYTE_TICKS,
+                             0, 0, 1, profiles[i].faults};
+        Sim_Stats stats = {0};
+        Sim_Stats pairing = {0};
+        uint32_t profile_seed = seed;
+
+        for (uint64_t j = 0; j < rallies; j++) {
+            sim_rally(&config, &profile_seed, &stats);
+        }
+        for (uint64_t j = 0; j < handshakes; j++) {
+            sim_handshake(&config, &profile_seed, &stats, 0);
+            sim_handshake(&config, &profile_seed, &pairing, 1);
+        }
+
+        uint64_t decided = stats.handshakes - stats.handshake_stalls;
+        uint64_t paired = pairing.handshakes - pairing.handshake_stalls;
+        printf("%-11s  %10.2f  %9.2f  %9.3f%%  %11llu  %12.2f  %8.3f%%  %8.3f%%  %10.2f  %8.3f%%  %8.3f%%\n",
+               profiles[i].name,
+               stats.deliveries ? TICKS_TO_MS((double)stats.handoff_ticks / stats.deliveries) : 0.0,
+               TICKS_TO_MS((double)stats.handoff_max),
+               PERCENT(stats.stalls, stats.rallies),
+               (unsigned long long)stats.retransmits,
+               decided ? TICKS_TO_MS((double)stats.handshake_ticks / decided) : 0.0,
+               PERCENT(stats.handshake_stalls, stats.handshakes),
+               PERCENT(stats.handshake_splits, stats.handshakes),
+               paired ? TICKS_TO_MS((double)pairing.handshake_ticks / paired) : 0.0,
+               PERCENT(pairing.handshake_stalls, pairing.handshakes),
+               PERCENT(pairing.handshake_splits, pairing.handshakes));
+    }
+    return EXIT_SUCCESS;
+}
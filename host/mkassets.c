@@ -0,0 +1,111 @@
+/** @file mkassets.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Builds the game's font from the glyphs its text actually uses.
+
+    Runs on the PC at build time. Collects every character of every TEXT
+    and GLYPHS entry in assets.def, looks each one up in font5x7.def and
+    writes glyphs.h: just those glyphs as a PROGMEM table, with the
+    characters they draw. Fails if a character has no glyph.
+
+    Usage: mkassets > glyphs.h
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "system.h"
+
+#define GLYPH_WIDTH 5
+#define CHARACTERS 128
+
+//Defines one glyph of the source font
+typedef struct {
+    char character;
+    uint8_t columns[GLYPH_WIDTH];
+} Glyph;
+
+static const Glyph font[] = {
+#define GLYPH(character, c0, c1, c2, c3, c4) {character, {c0, c1, c2, c3, c4}},
+#include "font5x7.def"
+#undef GLYPH
+};
+
+static const char* const strings[] = {
+#define TEXT(name, string) string,
+#define BITMAP(name, c0, c1, c2, c3, c4)
+#define ANIMATION(name, flags, ...)
+#define GLYPHS(string) string,
+#include "assets.def"
+#undef TEXT
+#undef BITMAP
+#undef ANIMATION
+#undef GLYPHS
+};
+
+#define FONT_SIZE (sizeof(font) / sizeof(font[0]))
+#define STRING_COUNT (sizeof(strings) / sizeof(strings[0]))
+
+
+/** Finds a character in the source font.
+    @param character Character to find
+    @return its glyph, or NULL if the font has none */
+static const Glyph* find_glyph(char character)
+{
+    for (size_t i = 0; i < FONT_SIZE; i++) {
+        if (font[i].character == character) {
+            return &font[i];
+        }
+    }
+    return NULL;
+}
+
+
+int main(void)
+{
+    bool used[CHARACTERS] = {0};
+    int count = 0;
+
+    for (size_t i = 0; i < STRING_COUNT; i++) {
+        for (const char* c = strings[i]; *c; c++) {
+            if ((uint8_t)*c >= CHARACTERS || !find_glyph(*c)) {
+                fprintf(stderr, "mkassets: no glyph for '%c' in \"%s\"\n", *c, strings[i]);
+                return EXIT_FAILURE;
+            }
+            used[(uint8_t)*c] = 1;
+        }
+    }
+    for (int c = 0; c < CHARACTERS; c++) {
+        count += used[c];
+    }
+
+    printf("/* Generated by host/mkassets from assets.def and font5x7.def. Do not edit. */\n\n");
+    printf("#ifndef GLYPHS_H\n#define GLYPHS_H\n\n");
+    printf("#include <stdint.h>\n#include <avr/pgmspace.h>\n\n");
+    printf("#define GLYPH_WIDTH %d\n", GLYPH_WIDTH);
+    printf("#define GLYPH_COUNT %d\n\n", count);
+
+    printf("/** Character drawn by each glyph, in order. */\n");
+    printf("static const char glyph_characters[GLYPH_COUNT + 1] PROGMEM = \"");
+    for (int c = 0; c < CHARACTERS; c++) {
+        if (used[c]) {
+            printf("%s%c", c == '"' || c == '\\' ? "\\" : "", c);
+        }
+    }
+    printf("\";\n\n");
+
+    printf("/** Columns of each glyph, bit n being row n. */\n");
+    printf("static const uint8_t glyph_columns[GLYPH_COUNT][GLYPH_WIDTH] PROGMEM = {\n");
+    for (int c = 0; c < CHARACTERS; c++) {
+        if (used[c]) {
+            const Glyph* glyph = find_glyph(c);
+            printf("    {");
+            for (int col = 0; col < GLYPH_WIDTH; col++) {
+                printf("0x%02X%s", glyph->columns[col], col < GLYPH_WIDTH - 1 ? ", " : "");
+            }
+            printf("}, /* '%c' */\n", c);
+        }
+    }
+    printf("};\n\n#endif //GLYPHS_H\n");
+    return EXIT_SUCCESS;
+}
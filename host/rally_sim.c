@@ -0,0 +1,166 @@
+/** @file rally_sim.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Runs batches of simulated rallies across all cores.
+
+    Usage: rally_sim [-n rallies] [-j threads] [-p random|track]
+                     [-k skill] [-m max_hits] [-l link_byte_ticks] [-s seed]
+                     [-a ai_skill] [-b balls]
+*/
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "task.h"
+#include "sim.h"
+#include "ai.h"
+#include "balls.h"
+
+#define DEFAULT_RALLIES 1000000
+#define DEFAULT_SKILL 90
+#define DEFAULT_MAX_HITS 100
+#define DEFAULT_SEED 2025
+#define DEFAULT_LINK_BYTE_TICKS 40
+#define MAX_THREADS 256
+
+//Defines the work handed to one thread
+typedef struct {
+    pthread_t thread;
+    const Sim_Config* config;
+    uint64_t rallies;
+    uint32_t seed;
+    Sim_Stats stats;
+} Worker;
+
+static const char* position_names[SIM_START_POSITIONS] = {
+#define SERVE(name, delta_x, delta_y, preview_dx, preview_y) #name,
+#include "serves.def"
+#undef SERVE
+};
+
+
+/** Plays one worker's share of the rallies.
+    @param arg Address of the Worker object
+    @return NULL */
+static void* run_worker(void* arg)
+{
+    Worker* worker = arg;
+    for (uint64_t i = 0; i < worker->rallies; i++) {
+        sim_rally(worker->config, &worker->seed, &worker->stats);
+    }
+    return NULL;
+}
+
+
+/** Prints the merged results of a run.
+    @param stats Merged stats
+    @param seconds Wall-clock time taken */
+static void report(const Sim_Stats* stats, double seconds)
+{
+    if (stats->rallies == 0) {
+        return;
+    }
+    printf("rallies            %llu\n", (unsigned long long)stats->rallies);
+    printf("mean rally length  %.3f hits\n", (double)stats->hits / stats->rallies);
+    printf("longest rally      %llu hits\n", (unsigned long long)stats->longest);
+    printf("handoffs           %llu\n", (unsigned long long)stats->handoffs);
+    printf("stopped at limit   %llu\n", (unsigned long long)stats->timeouts);
+    printf("missed by the AI   %llu\n", (unsigned long long)stats->ai_misses);
+    printf("score splits       %llu\n", (unsigned long long)stats->score_splits);
+    printf("\nserve  rallies     mean length  miss rate\n");
+    for (uint8_t i = 0; i < SIM_START_POSITIONS; i++) {
+        uint64_t arrivals = stats->returns[i] + stats->misses[i];
+        printf("%-5s  %-10llu  %-11.3f  %.4f\n", position_names[i],
+               (unsigned long long)stats->serves[i],
+               stats->serves[i] ? (double)stats->returns[i] / stats->serves[i] : 0.0,
+               arrivals ? (double)stats->misses[i] / arrivals : 0.0);
+    }
+    printf("\nwall time          %.3f s\n", seconds);
+    printf("rallies per second %.0f\n", stats->rallies / seconds);
+    printf("simulated ticks/s  %.3e\n", stats->ticks / seconds);
+    printf("speed-up           %.0fx real time\n", stats->ticks / (double)TASK_RATE / seconds);
+}
+
+
+int main(int argc, char** argv)
+{
+    Sim_Config config = {POLICY_TRACK, DEFAULT_SKILL, DEFAULT_MAX_HITS, DEFAULT_LINK_BYTE_TICKS, 0, AI_DEFAULT_SKILL, 1, {0}};
+    uint64_t rallies = DEFAULT_RALLIES;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t seed = DEFAULT_SEED;
+    int option;
+
+    while ((option = getopt(argc, argv, "n:j:p:k:m:l:s:a:b:")) != -1) {
+        switch (option) {
+            case 'n':
+                rallies = strtoull(optarg, NULL, 10);
+                break;
+            case 'j':
+                threads = strtol(optarg, NULL, 10);
+                break;
+            case 'p':
+                config.policy = strcmp(optarg, "random") == 0 ? POLICY_RANDOM : POLICY_TRACK;
+                break;
+            case 'k':
+                config.skill = strtoul(optarg, NULL, 10);
+                break;
+            case 'm':
+                config.max_hits = strtoul(optarg, NULL, 10);
+                break;
+            case 'l':
+                config.link_byte_ticks = strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                seed = strtoul(optarg, NULL, 10);
+                break;
+            case 'a':
+                config.ai = 1;
+                config.ai_skill = strtoul(optarg, NULL, 10);
+                break;
+            case 'b':
+                config.balls = strtoul(optarg, NULL, 10);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n rallies] [-j threads] [-p random|track]"
+                        " [-k skill] [-m max_hits] [-l link_byte_ticks] [-s seed] [-a ai_skill]"
+                        " [-b balls]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (config.balls > BALL_POOL_SIZE) {
+        config.balls = BALL_POOL_SIZE;
+    }
+    if (threads < 1) {
+        threads = 1;
+    } else if (threads > MAX_THREADS) {
+        threads = MAX_THREADS;
+    }
+
+    static Worker workers[MAX_THREADS];
+    struct timespec start, end;
+    Sim_Stats total = {0};
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long i = 0; i < threads; i++) {
+        workers[i].config = &config;
+        workers[i].rallies = rallies / threads + ((uint64_t)i < rallies % threads);
+        workers[i].seed = seed + 0x9E3779B9u * (i + 1); //never 0 for a sane seed
+        if (workers[i].seed == 0) {
+            workers[i].seed = 1;
+        }
+        pthread_create(&workers[i].thread, NULL, run_worker, &workers[i]);
+    }
+    for (long i = 0; i < threads; i++) {
+        pthread_join(workers[i].thread, NULL);
+        sim_stats_merge(&total, &workers[i].stats);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    printf("threads            %ld\n", threads);
+    report(&total, (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+    //Both boards must agree on every point, however many balls are in play
+    return total.score_splits ? EXIT_FAILURE : EXIT_SUCCESS;
+}
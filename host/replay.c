@@ -0,0 +1,390 @@
+/** @file replay.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Replays a recorded match through the game on a PC.
+
+    Runs the whole game, main() and all, against a log recorded on the
+    board (see recorder.h), injecting each navswitch edge and IR byte at
+    the exact input poll it was recorded at. Time is virtual, so every run
+    of the same log takes the same path and gives the same digest: an
+    FNV-1a hash of everything the board showed and sent. A change that
+    alters the digest has changed the game's behaviour. Built with PROFILE,
+    it also prints how long each stage of the game took on this PC.
+
+    It also times every North or South press made with the paddle alone in
+    its column, from just after the navswitch poll before the press, the
+    latest it can arrive unseen, to the display showing the paddle one row
+    over, in game time. Debouncing on the board adds
+    NAV_DEBOUNCE_SAMPLES / NAV_SAMPLE_RATE on top. Presses that do not move
+    the paddle within PADDLE_REPEAT_DELAY_MS, at the edge or in a menu, are
+    counted apart.
+
+    Built with TRACE, -t writes the game's event trace at the end of the
+    replay, for host/tracedump.
+
+    Usage: replay [-s settle_polls] [-d expected_digest] [-l latency_ms] [-t trace.bin] recording.bin
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "system.h"
+#include "navswitch.h"
+#include "task.h"
+#include "recorder.h"
+#include "profile.h"
+#include "trace.h"
+#include "paddle.h"
+#include "hw_shim.h"
+
+#define DEFAULT_SETTLE_POLLS 1000
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME 16777619u
+#define PADDLE_DISPLAY_COL COURT_COL(0)
+#define PADDLE_PATTERN (((column_t)1 << PADDLE_LENGTH) - 1)
+#define PADDLE_TOP_ROW (LEDMAT_ROWS_NUM - PADDLE_LENGTH)
+#define LATENCY_TIMEOUT ((uint32_t)TASK_RATE * PADDLE_REPEAT_DELAY_MS / 1000)
+#define NOT_TIMING -1
+
+int game_main(void);
+
+//Defines the replay in progress
+typedef struct {
+    Record* records;
+    uint16_t count;
+    uint16_t next;
+    uint16_t since;           //polls since the last record was applied
+    uint64_t polls;
+    uint64_t ticks;           //virtual timer ticks since the start
+    timer_tick_t last_now;
+    uint32_t settle;          //polls left to run after the last record
+    uint32_t digest;
+    bool check;
+    uint32_t expected;
+    struct timespec start;
+    int8_t press_row;         //row the paddle should move to, or NOT_TIMING
+    column_t press_left;      //cell the paddle leaves as it moves there
+    timer_tick_t press_at;    //timer tick of the press being timed
+    uint32_t presses;         //presses timed, and how many the paddle ignored
+    uint32_t ignored;
+    uint64_t latency_total;   //timer ticks from press to pixel
+    timer_tick_t latency_min;
+    timer_tick_t latency_max;
+    bool check_latency;
+    double latency_limit;     //ms
+    const char* trace_path;   //where to write the event trace, or NULL
+} Replay;
+
+static Replay replay;
+
+
+/** Adds a byte to the digest.
+    @param data Byte to add */
+static void digest_byte(uint8_t data)
+{
+    replay.digest = (replay.digest ^ data) * FNV_PRIME;
+}
+
+
+/** Converts timer ticks to ms.
+    @param ticks Timer ticks
+    @return ms */
+static double ticks_ms(uint64_t ticks)
+{
+    return ticks * 1000.0 / TASK_RATE;
+}
+
+
+/** Finds the paddle on the display.
+    @param column Paddle column as shown
+    @return lowest row of the paddle, or NOT_TIMING if anything else is lit */
+static int8_t paddle_row(column_t column)
+{
+    for (int8_t row = 0; row <= PADDLE_TOP_ROW; row++) {
+        if (column == (column_t)(PADDLE_PATTERN << row)) {
+            return row;
+        }
+    }
+    return NOT_TIMING;
+}
+
+
+/** Starts timing a press, if it can move the paddle one row.
+    @param court The replayed board
+    @param button Button pressed */
+static void start_press(const Court_IO* court, uint8_t button)
+{
+    int8_t row = paddle_row(court->columns[PADDLE_DISPLAY_COL]);
+
+    if (replay.press_row != NOT_TIMING || row == NOT_TIMING
+        || (button != NAVSWITCH_NORTH && button != NAVSWITCH_SOUTH)) {
+        return;
+    }
+    row += button == NAVSWITCH_NORTH ? -1 : 1;
+    if (row >= 0 && row <= PADDLE_TOP_ROW) {
+        replay.press_left = (column_t)1 << (button == NAVSWITCH_NORTH ? row + PADDLE_LENGTH : row - 1);
+        replay.press_row = row;
+        replay.press_at = court->nav_polled;
+    }
+}
+
+
+/** Called as each display column is driven. Stops timing a press once
+    the paddle shows where it moved to, and no longer where it was, or once the press has been ignored
+    for too long.
+    @param court The replayed board
+    @param col Column driven */
+static void check_press(Court_IO* court, uint8_t col)
+{
+    timer_tick_t latency = court->now - replay.press_at;
+    column_t moved_to;
+
+    if (replay.press_row == NOT_TIMING || col != PADDLE_DISPLAY_COL) {
+        return;
+    }
+    moved_to = PADDLE_PATTERN << replay.press_row;
+    //A ball passing through the column is ignored
+    if ((court->columns[col] & (moved_to | replay.press_left)) == moved_to) {
+        if (replay.presses == replay.ignored || latency < replay.latency_min) {
+            replay.latency_min = latency;
+        }
+        if (latency > replay.latency_max) {
+            replay.latency_max = latency;
+        }
+        replay.latency_total += latency;
+        replay.presses++;
+        replay.press_row = NOT_TIMING;
+    } else if (latency > LATENCY_TIMEOUT) {
+        replay.presses++;
+        replay.ignored++;
+        replay.press_row = NOT_TIMING;
+    }
+}
+
+
+/** Reads a recording dumped from EEPROM.
+    @param path File to read
+    @return 1 if the recording was read */
+static bool load(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    uint8_t bytes[RECORD_SIZE];
+
+    if (!file) {
+        perror(path);
+        return 0;
+    }
+    if (fread(bytes, 1, 2, file) != 2) {
+        fprintf(stderr, "%s: too short\n", path);
+        fclose(file);
+        return 0;
+    }
+    replay.count = bytes[0] | (uint16_t)bytes[1] << 8;
+    replay.records = malloc(replay.count * sizeof(Record));
+    if (replay.count == 0xFFFF || !replay.records) {
+        fprintf(stderr, "%s: no recording\n", path);
+        fclose(file);
+        return 0;
+    }
+    for (uint16_t i = 0; i < replay.count; i++) {
+        if (fread(bytes, 1, RECORD_SIZE, file) != RECORD_SIZE) {
+            fprintf(stderr, "%s: truncated at record %u\n", path, i);
+            fclose(file);
+            return 0;
+        }
+        recorder_unpack(bytes, &replay.records[i]);
+    }
+    fclose(file);
+    return 1;
+}
+
+
+/** Prints how to run the replay.
+    @param name Name the program was run as */
+static void usage(const char* name)
+{
+    fprintf(stderr, "usage: %s [-s settle_polls] [-d expected_digest] [-l latency_ms] [-t trace.bin]"
+            " recording.bin\n", name);
+}
+
+
+#ifdef TRACE
+/** Writes the event trace to a file, in its dump form.
+    @param path File to write */
+static void write_trace(const char* path)
+{
+    uint8_t bytes[TRACE_DUMP_SIZE];
+    FILE* file = fopen(path, "wb");
+
+    if (!file) {
+        perror(path);
+        return;
+    }
+    trace_pack(bytes);
+    if (fwrite(bytes, 1, TRACE_DUMP_SIZE, file) != TRACE_DUMP_SIZE) {
+        perror(path);
+    }
+    fclose(file);
+}
+#endif
+
+
+/** Prints the results of the replay and exits. */
+static void finish(void)
+{
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (end.tv_sec - replay.start.tv_sec) + (end.tv_nsec - replay.start.tv_nsec) / 1e9;
+    double game_seconds = replay.ticks / (double)TASK_RATE;
+    uint32_t moved = replay.presses - replay.ignored;
+
+    printf("records            %u\n", replay.count);
+    printf("input polls        %llu\n", (unsigned long long)replay.polls);
+    printf("game time          %.3f s\n", game_seconds);
+    printf("wall time          %.6f s\n", seconds);
+    printf("speed-up           %.0fx real time\n", game_seconds / seconds);
+    printf("digest             %08x\n", replay.digest);
+    printf("paddle presses     %u timed, %u ignored\n", moved, replay.ignored);
+    if (moved > 0) {
+        printf("input to pixel     %.1f / %.1f / %.1f ms min/mean/max\n", ticks_ms(replay.latency_min),
+               ticks_ms(replay.latency_total) / moved, ticks_ms(replay.latency_max));
+    }
+#ifdef TRACE
+    if (replay.trace_path) {
+        write_trace(replay.trace_path);
+        printf("trace written to   %s\n", replay.trace_path);
+    }
+#endif
+#ifdef PROFILE
+    printf("\nstage   runs       min ns  mean ns  max ns   histogram (<%u ns, x2 per bucket)\n",
+           PROFILE_BUCKET_BASE);
+    for (uint8_t i = 0; i < PROFILE_STAGES; i++) {
+        const Profile_Stats* stats = profile_stats(i);
+        if (stats->runs == 0) {
+            continue;
+        }
+        printf("%-6s  %-9lu  %-6lu  %-7lu  %-7lu ", profile_stage_name(i), (unsigned long)stats->runs,
+               (unsigned long)profile_cycles(stats->min),
+               (unsigned long)profile_cycles(stats->total / stats->runs),
+               (unsigned long)profile_cycles(stats->max));
+        for (uint8_t bucket = 0; bucket < PROFILE_BUCKETS; bucket++) {
+            printf(" %u", stats->histogram[bucket]);
+        }
+        printf("\n");
+    }
+#endif
+
+    if (replay.check && replay.digest != replay.expected) {
+        printf("MISMATCH: expected %08x\n", replay.expected);
+        exit(EXIT_FAILURE);
+    }
+    if (replay.check_latency && ticks_ms(replay.latency_max) > replay.latency_limit) {
+        printf("TOO SLOW: input to pixel over %.1f ms\n", replay.latency_limit);
+        exit(EXIT_FAILURE);
+    }
+    exit(EXIT_SUCCESS);
+}
+
+
+/** Called before every input poll. Hashes what the board is showing and
+    sending, then applies any records due at this poll.
+    @param court The replayed board */
+static void replay_poll(Court_IO* court)
+{
+    replay.polls++;
+    replay.ticks += (timer_tick_t)(court->now - replay.last_now);
+    replay.last_now = court->now;
+
+    //Everything the board sent since the last poll, then the display
+    while (link_pending(court->tx) > 0) {
+        digest_byte(court->tx->data[court->tx->tail]);
+        court->tx->tail = (court->tx->tail + 1) % LINK_BUFFER_SIZE;
+    }
+    for (uint8_t col = 0; col < LEDMAT_COLS_NUM; col++) {
+        for (uint8_t byte = 0; byte < sizeof(column_t); byte++) {
+            digest_byte(court->columns[col] >> (8 * byte));
+        }
+    }
+    digest_byte(court->now & 0xFF);
+    digest_byte(court->now >> 8);
+
+    replay.since++;
+    while (replay.next < replay.count && replay.records[replay.next].delta == replay.since) {
+        Record* record = &replay.records[replay.next];
+        switch (record->type) {
+            case RECORD_PUSH:
+                hw_shim_navswitch_set(record->data, 1);
+                start_press(court, record->data);
+                break;
+            case RECORD_RELEASE:
+                hw_shim_navswitch_set(record->data, 0);
+                break;
+            case RECORD_IR:
+                hw_shim_ir_inject(record->data);
+                break;
+            default:
+                break;
+        }
+        replay.since = 0;
+        replay.next++;
+    }
+
+    if (replay.next == replay.count && replay.settle-- == 0) {
+        finish();
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    Court_IO board, remote;
+    Link board_to_remote, remote_to_board;
+    int option;
+
+    replay.settle = DEFAULT_SETTLE_POLLS;
+    replay.press_row = NOT_TIMING;
+    while ((option = getopt(argc, argv, "s:d:l:t:")) != -1) {
+        switch (option) {
+            case 's':
+                replay.settle = strtoul(optarg, NULL, 10);
+                break;
+            case 'd':
+                replay.check = 1;
+                replay.expected = strtoul(optarg, NULL, 16);
+                break;
+            case 'l':
+                replay.check_latency = 1;
+                replay.latency_limit = strtod(optarg, NULL);
+                break;
+            case 't':
+#ifndef TRACE
+                fprintf(stderr, "%s: -t needs a TRACE build\n", argv[0]);
+                return EXIT_FAILURE;
+#endif
+                replay.trace_path = optarg;
+                break;
+            default:
+                usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (optind != argc - 1) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (!load(argv[optind])) {
+        return EXIT_FAILURE;
+    }
+
+    hw_shim_connect(&board, &remote, &board_to_remote, &remote_to_board, 0);
+    board.poll = replay_poll;
+    board.shown = check_press;
+    hw_shim_select(&board);
+    replay.digest = FNV_OFFSET;
+    clock_gettime(CLOCK_MONOTONIC, &replay.start);
+
+    //Never returns: replay_poll() exits once the recording has played
+    game_main();
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,416 @@
+/** @file sim.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Headless rally simulator.
+*/
+
+#include "system.h"
+#include "navswitch.h"
+#include "paddle.h"
+#include "projectile.h"
+#include "balls.h"
+#include "court.h"
+#include "states.h"
+#include "ir_transmission.h"
+#include "packet.h"
+#include "transport.h"
+#include "game.h"
+#include "ai.h"
+#include "score.h"
+#include "hw_shim.h"
+#include "sim.h"
+
+/*Task periods from game.h, in scheduler ticks*/
+#define BALL_PERIOD (TASK_RATE / BALL_TASK_RATE)
+#define PADDLE_PERIOD ((uint32_t)TASK_RATE * PADDLE_REPEAT_MS / 1000)
+#define STATE_PERIOD (TASK_RATE / STATE_TASK_RATE)
+#define COURT_CENTRE (COURT_MAX_X / 2)
+
+//Defines one simulated board
+typedef struct {
+    Court_IO io;
+    Paddle paddle;
+    Ball_Pool balls;
+    Court_Map map;
+    Transport transport;
+    State state;
+    Match_Record match;  //score of the rally, as game.c keeps it
+    Last_Point last_point;  //point last ended, as game.c keeps it
+} Court;
+
+
+/** Returns the next number from a xorshift generator.
+    @param seed Address of the generator state, must not be 0
+    @return pseudo-random 32-bit number */
+uint32_t sim_random(uint32_t* seed)
+{
+    uint32_t x = *seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *seed = x;
+    return x;
+}
+
+
+/** Moves a paddle the way the configured player would.
+    @param court Court whose paddle is moved
+    @param config Settings holding the input policy
+    @param seed Address of the random generator state */
+static void move_paddle(Court* court, const Sim_Config* config, uint32_t* seed)
+{
+    uint32_t roll = sim_random(seed);
+    int8_t target = COURT_CENTRE;
+    int8_t centre = COURT_ROW((get_paddle_top(&court->paddle) + get_paddle_bottom(&court->paddle)) / 2);
+
+    if (config->policy == POLICY_RANDOM) {
+        if (roll % 3 == 0) {
+            paddle_up(&court->paddle);
+        } else if (roll % 3 == 1) {
+            paddle_down(&court->paddle);
+        }
+        return;
+    }
+
+    //Tracks the lowest ball on its own court, otherwise returns to the centre
+    fixed_t lowest = FIXED(COURT_MAX_Y + 1);
+    for (uint8_t id = 0; id < BALL_POOL_SIZE; id++) {
+        if (court->balls.live & (1 << id) && court->balls.y[id] < lowest) {
+            lowest = court->balls.y[id];
+            target = FIXED_TO_CELL(court->balls.x[id]);
+        }
+    }
+    if (roll % 100 >= config->skill) {
+        target = COURT_MAX_X - target; //a mistake: heads the wrong way
+    }
+    //Moving up the display moves along the court when it is flipped
+    if (centre != target && (centre < target) == (COURT_FLIP_X != 0)) {
+        paddle_up(&court->paddle);
+    } else if (centre != target) {
+        paddle_down(&court->paddle);
+    }
+}
+
+
+/** Checks the rally left both courts with the same score, one point
+    played, and one of them to serve.
+    @param courts Both courts, once neither has anything in play or in flight
+    @return 1 if they agree */
+static bool scores_agree_p(const Court courts[2])
+{
+    const Match_Record* near = &courts[0].match;
+    const Match_Record* far = &courts[1].match;
+    return near->points == 1 && far->points == 1 && near->lost == far->won && near->won == far->lost
+           && near->serving != far->serving;
+}
+
+
+/** Brings a wakeup forward to a timer tick, if that is sooner.
+    @param tick Current scheduler tick
+    @param when Timer tick to wake at, now if already past
+    @param next Address of the next wakeup */
+static void wake_at(uint64_t tick, timer_tick_t when, uint64_t* next)
+{
+    int16_t wait = when - (timer_tick_t)tick;
+    uint64_t wakeup = wait > 0 ? tick + wait : tick;
+    if (wakeup < *next) {
+        *next = wakeup;
+    }
+}
+
+
+/** Plays one rally from serve to miss and adds it to the stats. Between
+    two courts the rally carries on until the miss has reached the other
+    court, which may still be playing other balls, and both have kept
+    the score.
+    @param config Settings for the rally
+    @param seed Address of the random generator state
+    @param stats Stats to add the rally to */
+void sim_rally(const Sim_Config* config, uint32_t* seed, Sim_Stats* stats)
+{
+    static const Pairing unpaired = {.opponent = PACKET_PAIR_NONE};
+    Court courts[2];
+    Link links[2];
+    Ai ai;
+    uint8_t court_count = config->ai ? 1 : 2;
+    Start_Position serve = sim_random(seed) % SIM_START_POSITIONS;
+    uint64_t tick = 0;
+    uint64_t next_ball = BALL_PERIOD;
+    uint64_t next_paddle = PADDLE_PERIOD;
+    uint64_t hits = 0;
+    uint64_t in_play = 0;      //last tick a ball was in play
+    uint64_t handoff_start[BALL_POOL_SIZE] = {0};
+    uint8_t in_flight = 0;     //balls sent and not yet arrived
+    Projectile ball;
+    bool missed = 0;
+    bool rally_over = 0;
+
+    hw_shim_connect(&courts[0].io, &courts[1].io, &links[0], &links[1], config->link_byte_ticks);
+    link_set_faults(&links[0], &config->faults, sim_random(seed));
+    link_set_faults(&links[1], &config->faults, sim_random(seed));
+    for (uint8_t i = 0; i < 2; i++) {
+        courts[i].paddle = init_paddle();
+        transport_reset(&courts[i].transport);
+        ball_pool_clear(&courts[i].balls);
+        court_load(&courts[i].map, LEVEL_OPEN);
+        courts[i].state = WAITING;
+        courts[i].match = (Match_Record){.in_match = 1, .serving = i == 0};
+        courts[i].last_point = (Last_Point){0};
+    }
+    ai_init(&ai, config->ai_skill, sim_random(seed));
+    ball_pool_serve(&courts[0].balls, serve, config->ai || config->balls < 1 ? 1 : config->balls);
+    courts[0].state = GAME_ON;
+    stats->serves[serve]++;
+
+    while (!rally_over) {
+        uint64_t next = next_ball < next_paddle ? next_ball : next_paddle;
+
+        //Wakes up when the transport has work, as the fast state task would
+        for (uint8_t i = 0; i < court_count && !config->ai; i++) {
+            if (link_pending(courts[i].io.rx) > 0) {
+                wake_at(tick, link_next_arrival(courts[i].io.rx), &next);
+            }
+            if (transport_busy_p(&courts[i].transport)) {
+                wake_at(tick, courts[i].transport.deadline, &next);
+            }
+        }
+        tick = next;
+        courts[0].io.now = (timer_tick_t)tick;
+        courts[1].io.now = (timer_tick_t)tick;
+
+        //Once a court has missed, only courts still playing move
+        if (tick == next_paddle) {
+            for (uint8_t i = 0; i < court_count; i++) {
+                if (!missed || courts[i].state == GAME_ON) {
+                    move_paddle(&courts[i], config, seed);
+                }
+            }
+            next_paddle += PADDLE_PERIOD;
+        }
+
+        //Steps the balls the way ball_task() in game.c does
+        if (tick == next_ball) {
+            for (uint8_t i = 0; i < court_count; i++) {
+                Court* court = &courts[i];
+                if (court->state == WAITING && config->ai) {
+                    Ai_Event event = ai_step(&ai, &ball);
+                    if (event == AI_RETURNED) {
+                        hits++;
+                        ball_pool_put(&court->balls, 0, &ball);
+                        court->state = GAME_ON;
+                    } else if (event == AI_MISSED) {
+                        stats->ai_misses++;
+                        rally_over = 1;
+                    }
+                    continue;
+                }
+                if (court->state != GAME_ON) {
+                    continue;
+                }
+                hw_shim_select(&court->io);
+                Ball_Events events = ball_pool_step(&court->balls, &court->paddle, &court->map);
+                hits += __builtin_popcount(events.returned);
+                if (events.missed) {
+                    if (!missed) {
+                        stats->misses[serve]++;
+                    }
+                    missed = 1;
+                    rally_over = config->ai;
+                    score_miss(&court->match, &court->last_point, &court->state, &court->balls, &court->map,
+                               LEVEL_OPEN, config->ai ? NULL : &court->transport);
+                    continue;
+                }
+                for (uint8_t id = 0; id < BALL_POOL_SIZE; id++) {
+                    if (!(events.crossed & (1 << id))) {
+                        continue;
+                    }
+                    stats->handoffs++;
+                    handoff_start[id] = tick;
+                    in_flight |= 1 << id;
+                    ball_pool_get(&court->balls, id, &ball);
+                    if (config->ai) {
+                        turn_projectile(&ball);
+                        ai_receive(&ai, &ball);
+                    } else {
+                        send_projectile(&court->transport, &ball, id);
+                    }
+                }
+                if (!court->balls.live) {
+                    court->state = WAITING;
+                }
+            }
+            next_ball += BALL_PERIOD;
+        }
+
+        //Polls the transport, keeps the score and takes the ball, as game_state() does
+        for (uint8_t i = 0; i < court_count && !rally_over && !config->ai; i++) {
+            Court* court = &courts[i];
+            hw_shim_select(&court->io);
+            transport_poll(&court->transport);
+            score_keep(&court->match, &court->last_point, &court->state, &court->balls, &court->map,
+                       LEVEL_OPEN, &court->transport, &unpaired);
+            if (court->state == BALL_SELECT) {
+                drop_projectiles(&court->transport);
+                continue;
+            }
+            uint8_t before = court->balls.live;
+            wait_for_data(&court->transport, &court->balls, &court->state);
+            for (uint8_t id = 0; id < BALL_POOL_SIZE; id++) {
+                if ((court->balls.live & ~before & in_flight) & (1 << id)) {
+                    in_flight &= ~(1 << id);
+                    uint64_t latency = tick - handoff_start[id];
+                    stats->deliveries++;
+                    stats->handoff_ticks += latency;
+                    if (latency > stats->handoff_max) {
+                        stats->handoff_max = latency;
+                    }
+                }
+            }
+        }
+
+        //The point is over once nothing is left in play, in flight or unacknowledged
+        if (missed && !rally_over && courts[0].state != GAME_ON && courts[1].state != GAME_ON
+            && !transport_busy_p(&courts[0].transport) && !transport_busy_p(&courts[1].transport)
+            && link_pending(courts[0].io.rx) == 0 && link_pending(courts[1].io.rx) == 0) {
+            if (!scores_agree_p(courts)) {
+                stats->score_splits++;
+            }
+            rally_over = 1;
+        }
+
+        //A ball lost on the link leaves both courts waiting for good
+        if (courts[0].state == GAME_ON || courts[1].state == GAME_ON || config->ai) {
+            in_play = tick;
+        } else if (tick - in_play > SIM_STALL_TICKS) {
+            stats->stalls++;
+            rally_over = 1;
+        }
+
+        if (hits >= config->max_hits) {
+            stats->timeouts++;
+            rally_over = 1;
+        }
+    }
+
+    for (uint8_t i = 0; i < court_count; i++) {
+        stats->retransmits += courts[i].transport.stats.retransmits;
+    }
+    stats->rallies++;
+    stats->ticks += tick;
+    stats->hits += hits;
+    stats->returns[serve] += hits;
+    if (hits > stats->longest) {
+        stats->longest = hits;
+    }
+}
+
+
+/** Plays the handshake that decides who starts between two boards, and
+    adds it to the stats. Either both players push to send a paper,
+    scissors or rock choice at once, or the boards pair by themselves.
+    Runs until both have decided who starts. Uses the real ir_transmission
+    module, which shares the animation and text modules between courts,
+    so only run it on one thread.
+    @param config Settings for the link
+    @param seed Address of the random generator state
+    @param stats Stats to add the handshake to
+    @param pairing 1 to pair automatically, 0 for paper, scissors, rock */
+void sim_handshake(const Sim_Config* config, uint32_t* seed, Sim_Stats* stats, bool pairing)
+{
+    Court courts[2];
+    Link links[2];
+    PSR_Handshake handshakes[2] = {{0}, {0}};
+    Pairing pairings[2];
+    Match_Record match = {0};
+    uint8_t opponent_lost;
+    uint64_t tick = 0;
+    bool decided = 0;
+
+    hw_shim_connect(&courts[0].io, &courts[1].io, &links[0], &links[1], config->link_byte_ticks);
+    link_set_faults(&links[0], &config->faults, sim_random(seed));
+    link_set_faults(&links[1], &config->faults, sim_random(seed));
+    for (uint8_t i = 0; i < 2; i++) {
+        transport_reset(&courts[i].transport);
+        courts[i].state = PSR_SELECT;
+        if (pairing) {
+            hw_shim_select(&courts[i].io);
+            start_pairing(&pairings[i], &courts[i].transport, sim_random(seed));
+            courts[i].state = PAIRING;
+        }
+    }
+
+    while (!decided && tick <= SIM_STALL_TICKS) {
+        courts[0].io.now = (timer_tick_t)tick;
+        courts[1].io.now = (timer_tick_t)tick;
+        decided = 1;
+        for (uint8_t i = 0; i < 2; i++) {
+            Court* court = &courts[i];
+            hw_shim_select(&court->io);
+            transport_poll(&court->transport);
+            if (court->state == PAIRING) {
+                auto_pair(&pairings[i], &handshakes[i], &court->transport, &court->state);
+            } else if (pairing && (court->state == BALL_SELECT || court->state == WAITING)) {
+                //A board that has decided still answers, as score_keep() does
+                receive_match(&court->transport, &match, &pairings[i], &opponent_lost);
+            }
+            //Both players choose and push at once, and again after a draw
+            if (court->state == PSR_SELECT) {
+                handshakes[i].selection = "RPS"[sim_random(seed) % 3];
+                handshakes[i].unsent = 1;
+                court->state = PSR_RESULT;
+            }
+            starting_player_select(&handshakes[i], &court->transport, &court->state);
+            if (court->state != BALL_SELECT && court->state != WAITING) {
+                decided = 0;
+            }
+        }
+        tick += STATE_PERIOD;
+    }
+
+    stats->handshakes++;
+    for (uint8_t i = 0; i < 2; i++) {
+        stats->retransmits += courts[i].transport.stats.retransmits;
+    }
+    if (!decided) {
+        stats->handshake_stalls++;
+    } else {
+        stats->handshake_ticks += tick;
+        if (courts[0].state == courts[1].state) {
+            stats->handshake_splits++;
+        }
+    }
+}
+
+
+/** Adds one set of stats to another.
+    @param total Stats to add to
+    @param part Stats to add */
+void sim_stats_merge(Sim_Stats* total, const Sim_Stats* part)
+{
+    total->rallies += part->rallies;
+    total->ticks += part->ticks;
+    total->hits += part->hits;
+    total->handoffs += part->handoffs;
+    total->timeouts += part->timeouts;
+    total->ai_misses += part->ai_misses;
+    total->stalls += part->stalls;
+    total->score_splits += part->score_splits;
+    total->deliveries += part->deliveries;
+    total->handoff_ticks += part->handoff_ticks;
+    total->retransmits += part->retransmits;
+    if (part->handoff_max > total->handoff_max) {
+        total->handoff_max = part->handoff_max;
+    }
+    total->handshakes += part->handshakes;
+    total->handshake_ticks += part->handshake_ticks;
+    total->handshake_stalls += part->handshake_stalls;
+    total->handshake_splits += part->handshake_splits;
+    if (part->longest > total->longest) {
+        total->longest = part->longest;
+    }
+    for (uint8_t i = 0; i < SIM_START_POSITIONS; i++) {
+        total->serves[i] += part->serves[i];
+        total->returns[i] += part->returns[i];
+        total->misses[i] += part->misses[i];
+    }
+}
@@ -0,0 +1,101 @@
+/** @file sim.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Headless rally simulator.
+
+    Plays whole rallies between two courts joined by an in-memory IR
+    link, using the real projectile, paddle and IR transmission modules,
+    or between one court and the AI of the single-player game.
+    Time is counted in scheduler ticks (TASK_RATE per second) and the
+    paddle and ball move at the task rates in game.h, but ticks in which
+    nothing moves are skipped.
+*/
+
+#ifndef SIM_H
+#define SIM_H
+
+#include "system.h"
+#include "projectile.h"
+#include "hw_shim.h"
+
+#define SIM_START_POSITIONS SERVE_COUNT
+#define SIM_STALL_TICKS (2 * TIMER_RATE)  //no ball in play for this long is a stall
+
+//Defines how the simulated players move their paddles
+typedef enum {
+    POLICY_RANDOM,
+    POLICY_TRACK
+} Input_Policy;
+
+//Defines the settings for a batch of rallies
+typedef struct {
+    Input_Policy policy;
+    uint8_t skill;      //percent chance a tracking player moves the right way
+    uint16_t max_hits;  //rallies longer than this are stopped
+    uint16_t link_byte_ticks;  //IR airtime of one byte, in scheduler ticks
+    bool ai;            //1 to play the far court with the AI
+    uint8_t ai_skill;   //skill of the AI, 0 to AI_SKILL_LEVELS - 1
+    uint8_t balls;      //balls served at once, 1 to BALL_POOL_SIZE. 1 against the AI
+    Link_Faults faults; //faults injected on both directions of the link
+} Sim_Config;
+
+//Defines the results of a batch of rallies, indexed by Start_Position
+typedef struct {
+    uint64_t rallies;
+    uint64_t ticks;
+    uint64_t hits;
+    uint64_t handoffs;
+    uint64_t timeouts;
+    uint64_t longest;
+    uint64_t ai_misses;
+    uint64_t stalls;            //rallies stopped with the ball lost between courts
+    uint64_t score_splits;      //rallies after which the courts disagreed on the score
+    uint64_t deliveries;        //handoffs that arrived
+    uint64_t handoff_ticks;     //total and worst time from leaving one court to play on the other
+    uint64_t handoff_max;
+    uint64_t retransmits;       //frames sent again after a lost message or acknowledgement
+    uint64_t handshakes;
+    uint64_t handshake_ticks;   //total time until both boards had decided the starting player
+    uint64_t handshake_stalls;  //handshakes not decided within SIM_STALL_TICKS
+    uint64_t handshake_splits;  //handshakes where the boards disagreed on who starts
+    uint64_t serves[SIM_START_POSITIONS];
+    uint64_t returns[SIM_START_POSITIONS];
+    uint64_t misses[SIM_START_POSITIONS];
+} Sim_Stats;
+
+
+/** Returns the next number from a xorshift generator.
+    @param seed Address of the generator state, must not be 0
+    @return pseudo-random 32-bit number */
+uint32_t sim_random(uint32_t* seed);
+
+
+/** Plays one rally from serve to miss and adds it to the stats. Between
+    two courts the rally carries on until the miss has reached the other
+    court, which may still be playing other balls, and both have kept
+    the score.
+    @param config Settings for the rally
+    @param seed Address of the random generator state
+    @param stats Stats to add the rally to */
+void sim_rally(const Sim_Config* config, uint32_t* seed, Sim_Stats* stats);
+
+
+/** Plays the handshake that decides who starts between two boards, and
+    adds it to the stats. Either both players push to send a paper,
+    scissors or rock choice at once, or the boards pair by themselves.
+    Runs until both have decided who starts. Uses the real ir_transmission
+    module, which shares the animation and text modules between courts,
+    so only run it on one thread.
+    @param config Settings for the link
+    @param seed Address of the random generator state
+    @param stats Stats to add the handshake to
+    @param pairing 1 to pair automatically, 0 for paper, scissors, rock */
+void sim_handshake(const Sim_Config* config, uint32_t* seed, Sim_Stats* stats, bool pairing);
+
+
+/** Adds one set of stats to another.
+    @param total Stats to add to
+    @param part Stats to add */
+void sim_stats_merge(Sim_Stats* total, const Sim_Stats* part);
+
+#endif //SIM_H
@@ -0,0 +1,300 @@
+/** @file tracedump.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Prints an event trace as a timeline, with latency statistics.
+
+    Reads a dump of the trace ring (see trace.h), from "make dump-trace"
+    or "host/replay -t", and prints every record oldest first, at its time
+    from the first. It then reports how often each state was entered and
+    how long it was held, the time from sending a ball to the other board
+    acknowledging it, and the time from a ball arriving to this board
+    returning it. A trace that ends with sends unacknowledged, or in
+    WAITING, shows where a match stalled.
+
+    Usage: tracedump [-q] trace.bin
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "system.h"
+#include "timer.h"
+#include "states.h"
+#include "trace.h"
+
+#define TICKS_TO_MS(ticks) ((ticks) * 1000.0 / TIMER_RATE)
+#define STATES (GAME_ON + 1)
+#define SEQS 16   //handoff sequence numbers, 4 bits
+#define BALLS 16  //handoff ball IDs, 4 bits
+
+//Defines a running min, mean and max, in timer ticks
+typedef struct {
+    uint32_t count;
+    uint64_t total;
+    uint32_t min;
+    uint32_t max;
+} Stat;
+
+static const char* const state_names[STATES] = {
+    [BEGIN] = "BEGIN",
+    [PRESS_TO_START] = "PRESS_TO_START",
+    [RESUME] = "RESUME",
+    [MODE_SELECT] = "MODE_SELECT",
+    [LEVEL_SELECT] = "LEVEL_SELECT",
+    [PAIRING] = "PAIRING",
+    [PSR_SELECT] = "PSR_SELECT",
+    [PSR_READY] = "PSR_READY",
+    [PSR_RESULT] = "PSR_RESULT",
+    [BALL_SELECT] = "BALL_SELECT",
+    [WAITING] = "WAITING",
+    [GAME_ON] = "GAME_ON",
+};
+
+static const char* const type_names[TRACE_TYPES] = {
+    [TRACE_NONE] = "NONE",
+    [TRACE_STATE] = "STATE",
+    [TRACE_SEND] = "SEND",
+    [TRACE_ACK] = "ACK",
+    [TRACE_RECEIVE] = "RECEIVE",
+    [TRACE_HIT] = "HIT",
+    [TRACE_MISS] = "MISS",
+};
+
+
+/** Adds one time to a stat.
+    @param stat Stat to add to
+    @param ticks Time in timer ticks */
+static void stat_add(Stat* stat, uint32_t ticks)
+{
+    if (stat->count == 0 || ticks < stat->min) {
+        stat->min = ticks;
+    }
+    if (ticks > stat->max) {
+        stat->max = ticks;
+    }
+    stat->total += ticks;
+    stat->count++;
+}
+
+
+/** Prints a stat as a line of the report.
+    @param name What was timed
+    @param stat Stat to print */
+static void stat_print(const char* name, const Stat* stat)
+{
+    if (stat->count == 0) {
+        printf("%-24s %5u\n", name, 0);
+        return;
+    }
+    printf("%-24s %5u  %8.1f  %8.1f  %8.1f\n", name, stat->count, TICKS_TO_MS(stat->min),
+           TICKS_TO_MS((double)stat->total / stat->count), TICKS_TO_MS(stat->max));
+}
+
+
+/** Returns the name of a state.
+    @param state State traced
+    @return its name, or "?" */
+static const char* state_name(uint8_t state)
+{
+    return state < STATES ? state_names[state] : "?";
+}
+
+
+/** Prints a ball mask as a list of IDs, e.g. "0,2".
+    @param mask Balls, one bit per ID */
+static void print_balls(uint8_t mask)
+{
+    const char* separator = "";
+    for (uint8_t id = 0; mask; id++, mask >>= 1) {
+        if (mask & 1) {
+            printf("%s%u", separator, id);
+            separator = ",";
+        }
+    }
+}
+
+
+/** Prints one record of the timeline.
+    @param ms Time from the first record
+    @param record Record to print */
+static void print_record(double ms, const Trace_Record* record)
+{
+    printf("%10.1f ms  %-8s ", ms, type_names[record->type]);
+    switch (record->type) {
+        case TRACE_STATE:
+            printf("%s", state_name(record->data));
+            break;
+        case TRACE_SEND:
+            printf("ball %u ", TRACE_HANDOFF_ID(record->data));
+            if (TRACE_HANDOFF_SEQ(record->data) == TRACE_NO_SEQ) {
+                printf("not sent, outbox full");
+            } else {
+                printf("seq %u", TRACE_HANDOFF_SEQ(record->data));
+            }
+            break;
+        case TRACE_ACK:
+            printf("seq %u", record->data);
+            break;
+        case TRACE_RECEIVE:
+            printf("ball %u%s", record->data & ~TRACE_DROPPED,
+                   record->data & TRACE_DROPPED ? " dropped, slot in use" : "");
+            break;
+        case TRACE_HIT:
+        case TRACE_MISS:
+            printf("balls ");
+            print_balls(TRACE_PADDLE_BALLS(record->data));
+            printf(", paddle bottom row %u", TRACE_PADDLE_BOTTOM(record->data));
+            break;
+    }
+    printf("\n");
+}
+
+
+int main(int argc, char** argv)
+{
+    uint8_t bytes[TRACE_DUMP_SIZE];
+    bool quiet = 0;
+    int option;
+
+    while ((option = getopt(argc, argv, "q")) != -1) {
+        switch (option) {
+            case 'q':
+                quiet = 1;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-q] trace.bin\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (optind != argc - 1) {
+        fprintf(stderr, "usage: %s [-q] trace.bin\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE* file = fopen(argv[optind], "rb");
+    if (!file) {
+        perror(argv[optind]);
+        return EXIT_FAILURE;
+    }
+    if (fread(bytes, 1, TRACE_DUMP_SIZE, file) != TRACE_DUMP_SIZE) {
+        fprintf(stderr, "%s: too short\n", argv[optind]);
+        fclose(file);
+        return EXIT_FAILURE;
+    }
+    fclose(file);
+    if ((bytes[0] | bytes[1] << 8) != TRACE_MAGIC || bytes[2] != TRACE_VERSION) {
+        fprintf(stderr, "%s: no trace\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    Stat dwell[STATES] = {{0}};
+    Stat handoff = {0};
+    Stat on_court = {0};
+    uint32_t sent_at[SEQS], arrived_at[BALLS];
+    uint16_t sending = 0, arrived = 0;   //one bit per sequence number, and per ball
+    uint32_t hits = 0, misses = 0, overflows = 0, dropped = 0, records = 0;
+    uint8_t state = STATES;
+    uint32_t entered = 0, now = 0;
+    uint16_t last_tick = 0;
+
+    //Oldest record first: the ring is written at head, over the oldest
+    for (uint8_t i = 0; i < TRACE_SIZE; i++) {
+        const uint8_t* packed = &bytes[4 + ((bytes[3] + i) & (TRACE_SIZE - 1)) * TRACE_RECORD_SIZE];
+        Trace_Record record = {.tick = packed[0] | packed[1] << 8, .type = packed[2], .data = packed[3]};
+
+        if (record.type == TRACE_NONE) {
+            continue;
+        }
+        if (record.type >= TRACE_TYPES) {
+            fprintf(stderr, "record %u: unknown type %u\n", i, record.type);
+            continue;
+        }
+        if (records++ > 0) {
+            now += (uint16_t)(record.tick - last_tick);
+        }
+        last_tick = record.tick;
+        if (!quiet) {
+            print_record(TICKS_TO_MS(now), &record);
+        }
+
+        switch (record.type) {
+            case TRACE_STATE:
+                if (state < STATES) {
+                    stat_add(&dwell[state], now - entered);
+                }
+                state = record.data;
+                entered = now;
+                break;
+            case TRACE_SEND:
+                if (TRACE_HANDOFF_SEQ(record.data) == TRACE_NO_SEQ) {
+                    overflows++;
+                } else {
+                    sent_at[TRACE_HANDOFF_SEQ(record.data)] = now;
+                    sending |= 1 << TRACE_HANDOFF_SEQ(record.data);
+                }
+                break;
+            case TRACE_ACK:
+                if (sending & (1 << (record.data % SEQS))) {
+                    stat_add(&handoff, now - sent_at[record.data % SEQS]);
+                    sending &= ~(1 << (record.data % SEQS));
+                }
+                break;
+            case TRACE_RECEIVE:
+                if (record.data & TRACE_DROPPED) {
+                    dropped++;
+                } else {
+                    arrived_at[record.data % BALLS] = now;
+                    arrived |= 1 << (record.data % BALLS);
+                }
+                break;
+            case TRACE_HIT:
+            case TRACE_MISS:
+                for (uint8_t id = 0; id < BALLS; id++) {
+                    if (!(TRACE_PADDLE_BALLS(record.data) & (1 << id))) {
+                        continue;
+                    }
+                    if (record.type == TRACE_HIT) {
+                        hits++;
+                        if (arrived & (1 << id)) {
+                            stat_add(&on_court, now - arrived_at[id]);
+                        }
+                    } else {
+                        misses++;
+                    }
+                    arrived &= ~(1 << id);
+                }
+                break;
+        }
+    }
+
+    if (!quiet) {
+        printf("\n");
+    }
+    printf("records %u over %.1f ms\n\n", records, TICKS_TO_MS(now));
+    printf("%-24s %5s  %8s  %8s  %8s\n", "ms", "count", "min", "mean", "max");
+    for (uint8_t i = 0; i < STATES; i++) {
+        if (dwell[i].count > 0) {
+            char name[32];
+            snprintf(name, sizeof(name), "in %s", state_names[i]);
+            stat_print(name, &dwell[i]);
+        }
+    }
+    stat_print("send to ack", &handoff);
+    stat_print("arrival to return", &on_court);
+    printf("\nhits %u, misses %u, sends with the outbox full %u, balls dropped %u\n",
+           hits, misses, overflows, dropped);
+    if (state < STATES) {
+        printf("last state %s, entered %.1f ms before the last record\n", state_names[state],
+               TICKS_TO_MS(now - entered));
+    }
+    if (sending) {
+        printf("sends never acknowledged, seq:");
+        for (uint8_t seq = 0; seq < SEQS; seq++) {
+            if (sending & (1 << seq)) {
+                printf(" %u", seq);
+            }
+        }
+        printf("\n");
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+/** @file input.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Single entry point for navswitch and IR input.
+*/
+
+#include "system.h"
+#include "navswitch.h"
+#include "ir_serial.h"
+#include "nav_events.h"
+#include "input.h"
+
+#ifdef RECORD
+#include "recorder.h"
+#endif
+
+/** Buttons down, and pressed or released at the last update, one bit per button. */
+static uint8_t buttons_down;
+static uint8_t buttons_pushed;
+static uint8_t buttons_released;
+
+
+/** Starts navswitch sampling, and the recorder if recording. */
+void input_init(void)
+{
+    buttons_down = 0;
+    buttons_pushed = 0;
+    buttons_released = 0;
+    nav_events_init();
+#ifdef RECORD
+    recorder_init();
+#endif
+}
+
+
+/** Takes the navswitch events queued since the last update. A press and
+    release in between both show up, as a push and a release event. */
+void input_update(void)
+{
+    Nav_Event events[NAV_EVENTS_SIZE];
+    uint8_t count = nav_events_take(events, NAV_EVENTS_SIZE);
+
+    buttons_pushed = 0;
+    buttons_released = 0;
+#ifdef RECORD
+    recorder_tick();
+#endif
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t mask = 1 << events[i].button;
+        if (events[i].pressed) {
+            buttons_down |= mask;
+            buttons_pushed |= mask;
+        } else {
+            buttons_down &= ~mask;
+            buttons_released |= mask;
+        }
+#ifdef RECORD
+        recorder_log(events[i].pressed ? RECORD_PUSH : RECORD_RELEASE, events[i].button);
+#endif
+    }
+}
+
+
+/** Returns whether a button is held down, as of the last update.
+    @param button NAVSWITCH_NORTH, ..., NAVSWITCH_PUSH
+    @return 1 if held down */
+bool input_down_p(uint8_t button)
+{
+    return (buttons_down >> button) & 1;
+}
+
+
+/** Returns whether a button was pushed at the last update. Reading the
+    push clears it, as navswitch_push_event_p() does.
+    @param button NAVSWITCH_NORTH, ..., NAVSWITCH_PUSH
+    @return 1 if pushed */
+bool input_push_event_p(uint8_t button)
+{
+    uint8_t mask = 1 << button;
+    bool pushed = buttons_pushed & mask;
+    buttons_pushed &= ~mask;
+    return pushed;
+}
+
+
+/** Polls the IR receiver for a byte, as ir_serial_receive() does.
+    @param data Address to store the byte received
+    @return IR_SERIAL_OK if a byte was received */
+ir_serial_ret_t input_ir_receive(uint8_t* data)
+{
+    ir_serial_ret_t ret = ir_serial_receive(data);
+#ifdef RECORD
+    recorder_tick();
+    if (ret == IR_SERIAL_OK) {
+        recorder_log(RECORD_IR, *data);
+    }
+#endif
+    return ret;
+}
@@ -0,0 +1,48 @@
+/** @file input.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Single entry point for navswitch and IR input.
+
+    All game code reads the navswitch and polls the IR receiver through
+    here, so each poll is one input tick for the recorder. Navswitch
+    presses arrive as debounced events from nav_events.h, queued under
+    interrupt, so none are lost while the game is busy elsewhere. Built
+    with RECORD defined, every navswitch event and every received IR byte
+    is logged.
+*/
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include "system.h"
+#include "ir_serial.h"
+
+
+/** Starts navswitch sampling, and the recorder if recording. */
+void input_init(void);
+
+
+/** Takes the navswitch events queued since the last update. A press and
+    release in between both show up, as a push and a release event. */
+void input_update(void);
+
+
+/** Returns whether a button is held down, as of the last update.
+    @param button NAVSWITCH_NORTH, ..., NAVSWITCH_PUSH
+    @return 1 if held down */
+bool input_down_p(uint8_t button);
+
+
+/** Returns whether a button was pushed at the last update. Reading the
+    push clears it, as navswitch_push_event_p() does.
+    @param button NAVSWITCH_NORTH, ..., NAVSWITCH_PUSH
+    @return 1 if pushed */
+bool input_push_event_p(uint8_t button);
+
+
+/** Polls the IR receiver for a byte, as ir_serial_receive() does.
+    @param data Address to store the byte received
+    @return IR_SERIAL_OK if a byte was received */
+ir_serial_ret_t input_ir_receive(uint8_t* data);
+
+#endif //INPUT_H
@@ -4,41 +4,196 @@
     @brief Controls IR communications of the game. 
 */
 
+#include <avr/pgmspace.h>
 #include "ir_transmission.h"
 #include "projectile.h"
-#include "ir_serial.h"
+#include "transport.h"
+#include "balls.h"
 #include "navswitch.h"
+#include "input.h"
 #include "paddle.h"
-#include "tinygl.h"
+#include "framebuffer.h"
+#include "text.h"
+#include "assets.h"
+#include "anim.h"
 #include "states.h"
 #include "system.h"
+#include "packet.h"
+#include "timer.h"
+#include "game.h"
+#include "trace.h"
 
-/** Selects paper, scissors or rock to determine starting player
-    @param selection Char address to store selected paper/scissors/rock*/
-void select_PSR(char* selection)
-{
-    bool selected = 0;
-    char choice_array[3] = {'R', 'P', 'S'};
-    uint8_t i = 0;
-    while (!selected) {
-        navswitch_update();
-        //de/in-crements the index by 1, looping around R/P/S
-        if (navswitch_push_event_p (NAVSWITCH_SOUTH)) {
-            i = (i+2) % 3; 
-        } else if (navswitch_push_event_p (NAVSWITCH_NORTH)) {
-            i = (i+1) % 3;
-        } else if (navswitch_push_event_p (NAVSWITCH_PUSH)) {
-            //makes selection and sends to opponent
-            selected = 1;
-            *selection = choice_array[i];
-            tinygl_clear();
+#define BALL_PERIOD (TIMER_RATE / BALL_TASK_RATE)
+#define MAX_CATCH_UP_STEPS 8
+
+/*Fields of a MATCH_RESUME value: who serves, whether it answers a
+    request, and every point the sender has won. The receiver checks
+    them against the points it has lost, so between them the request
+    and its reply check the whole score*/
+#define RESUME_SERVING 0x200
+#define RESUME_REPLY 0x100
+#define RESUME_WON_MASK 0xFF
+
+/** Takes the opponent's paper/scissors/rock choice if it has arrived.
+    Other match messages left over from an earlier match are dropped.
+    @param handshake Handshake to store it in
+    @param transport Transport it arrives on */
+static void receive_opponent(PSR_Handshake* handshake, Transport* transport)
+{
+    uint16_t payload;
+    if (!handshake->received && transport_take(transport, PACKET_MATCH, &payload, NULL)
+        && PACKET_MATCH_KIND(payload) == MATCH_CHOICE) {
+        handshake->opponent = payload;
+        handshake->received = 1;
+    }
+}
+
+
+/** Selects paper, scissors or rock to determine starting player.
+    Call once per tick in PSR_SELECT.
+    @param handshake Handshake to store the selection in
+    @param transport Transport the opponent's selection arrives on
+    @param state Changes to PSR_READY once a selection is made */
+void select_PSR(PSR_Handshake* handshake, Transport* transport, State* state)
+{
+    //The opponent may choose first
+    receive_opponent(handshake, transport);
+
+    //de/in-crements the index by 1, looping around R/P/S
+    if (input_push_event_p(NAVSWITCH_SOUTH)) {
+        handshake->choice = (handshake->choice + 2) % 3;
+    } else if (input_push_event_p(NAVSWITCH_NORTH)) {
+        handshake->choice = (handshake->choice + 1) % 3;
+    } else if (input_push_event_p(NAVSWITCH_PUSH)) {
+        //makes selection, sent to the opponent on the next push
+        handshake->selection = pgm_read_byte(&text_PSR_CHOICES[handshake->choice]);
+        text_clear();
+        *state = PSR_READY;
+        return;
+    }
+    //Displays character.
+    text_char(pgm_read_byte(&text_PSR_CHOICES[handshake->choice]));
+}
+
+/** Draws a new nonce from the pairing's seed, never PACKET_PAIR_NONE and
+    never one drawn before in this pairing, so a message naming an old
+    nonce cannot pass for one naming the new. Call only while
+    pairing_spent_p() is 0.
+    @param pairing Pairing to draw for */
+static void draw_nonce(Pairing* pairing)
+{
+    uint8_t nonce;
+    do {
+        pairing->seed ^= pairing->seed << 7;
+        pairing->seed ^= pairing->seed >> 9;
+        pairing->seed ^= pairing->seed << 8;
+        nonce = pairing->seed & PACKET_PAIR_NONCE_MASK;
+    } while (nonce == PACKET_PAIR_NONE || (pairing->drawn & (1 << nonce)));
+    pairing->drawn |= 1 << nonce;
+    pairing->nonce = nonce;
+}
+
+/** Checks if every nonce has been drawn in a pairing.
+    @param pairing Pairing to check
+    @return 1 once no nonce is left to draw */
+static bool pairing_spent_p(const Pairing* pairing)
+{
+    return pairing->drawn == (1 << PACKET_PAIR_NONE) - 1;
+}
+
+/** Starts pairing with the opponent, by sending it a random nonce.
+    Call on entering PAIRING.
+    @param pairing Pairing to start
+    @param transport Transport to send the nonce on
+    @param seed Source of the nonce, e.g. the timer when the player pushed */
+void start_pairing(Pairing* pairing, Transport* transport, uint16_t seed)
+{
+    *pairing = (Pairing){.seed = seed ? seed : 1, .nonce = PACKET_PAIR_NONE, .opponent = PACKET_PAIR_NONE};
+    draw_nonce(pairing);
+    pairing->unsent = !transport_send(transport, PACKET_MATCH,
+                                      packet_pair_payload(pairing->nonce, PACKET_PAIR_NONE));
+    pairing->resend_at = timer_get() + PAIR_INTERVAL;
+    text_scroll_P(text_PAIRING);
+}
+
+/** Decides who serves without any input. Each board sends its own nonce
+    with the opponent's as last heard, and once it has sent the pair
+    (own, opponent) and heard the same pair back, the board with the
+    larger nonce serves. Equal nonces are drawn again, forgetting the
+    opponent's, until every nonce has tied, when it goes to the manual
+    handshake. Both nonces are sent again every PAIR_INTERVAL until
+    decided, in case a message was lost in a way the transport could not
+    see, and on the next tick if the outbox is full.
+    Pushing the navswitch, or an opponent that has gone to paper, scissors,
+    rock, switches to the manual handshake. Call once per tick in PAIRING.
+    @param pairing Pairing started by start_pairing()
+    @param handshake Handshake to keep an opponent's paper/scissors/rock in
+    @param transport Transport the nonces arrive on
+    @param state BALL_SELECT or WAITING once decided, or PSR_SELECT */
+void auto_pair(Pairing* pairing, PSR_Handshake* handshake, Transport* transport, State* state)
+{
+    uint16_t payload;
+
+    if (input_push_event_p(NAVSWITCH_PUSH)) {
+        *handshake = (PSR_Handshake){0};
+        text_clear();
+        *state = PSR_SELECT;
+        return;
+    }
+
+    while (transport_take(transport, PACKET_MATCH, &payload, NULL)) {
+        uint16_t value = PACKET_MATCH_VALUE(payload);
+        uint8_t nonce = PACKET_PAIR_NONCE(value);
+        switch (PACKET_MATCH_KIND(payload)) {
+            case MATCH_CHOICE:
+                //The opponent chose to play paper, scissors, rock
+                *handshake = (PSR_Handshake){.opponent = value, .received = 1};
+                text_clear();
+                *state = PSR_SELECT;
+                return;
+            case MATCH_PAIR:
+                if (nonce == pairing->nonce && pairing_spent_p(pairing)) {
+                    //Every nonce has tied, and one used again could match an
+                    //old message, so the players choose instead
+                    *handshake = (PSR_Handshake){0};
+                    text_clear();
+                    *state = PSR_SELECT;
+                    return;
+                } else if (nonce == pairing->nonce) {
+                    //A tie: both boards draw again, and forget what they heard
+                    draw_nonce(pairing);
+                    pairing->opponent = PACKET_PAIR_NONE;
+                    pairing->confirmed = 0;
+                    pairing->unsent = 1;
+                } else {
+                    //Only the latest message counts, so a confirm is for its pair alone
+                    if (nonce != pairing->opponent) {
+                        pairing->opponent = nonce;
+                        pairing->unsent = 1;
+                    }
+                    pairing->confirmed = PACKET_PAIR_SEEN(value) == pairing->nonce;
+                }
+                break;
+            default:
+                break;
         }
-        //Displays character.
-        char buffer[2] = {choice_array[i], '\0'};
-        tinygl_text(buffer);
-        tinygl_update();
     }
 
+    //Sent again on the next tick if the outbox is full
+    bool resend = !transport_busy_p(transport) && (int16_t)(timer_get() - pairing->resend_at) >= 0;
+    if (pairing->unsent || resend) {
+        if (transport_send(transport, PACKET_MATCH, packet_pair_payload(pairing->nonce, pairing->opponent))) {
+            pairing->unsent = 0;
+            pairing->resend_at = timer_get() + PAIR_INTERVAL;
+        }
+    }
+
+    //Both boards have now sent the same pair, so compare the same two nonces
+    if (pairing->confirmed && !pairing->unsent) {
+        text_clear();
+        framebuffer_show(FRAMEBUFFER_ALL_LAYERS);
+        *state = pairing->nonce > pairing->opponent ? BALL_SELECT : WAITING;
+    }
 }
 
 /** Helper function to check for winner of paper, scissors, rock.
@@ -97,94 +252,229 @@ void check_winner(char selection, char opponent, bool* restart, State* state)
     }
 }
 
-/** Uses paper, scissors, rock to determine starting player
+/** Uses paper, scissors, rock to determine starting player.
+    Call once per tick in PSR_READY and PSR_RESULT.
+    @param handshake Selection made, and what has arrived from the opponent
+    @param transport Transport to send the selection on
     @param state Game state to change depending on winner */
-void starting_player_select(State* state)
+void starting_player_select(PSR_Handshake* handshake, Transport* transport, State* state)
 {
-    char selection = 'R'; //default is rock
-    char opponent;
     bool restart = 1;
-    bool received = 0;
-
-    //Restarts selection loop until winner is determined
-    while (restart) {
-        received = 0;
-
-        //Writes paper/scissors/rock to selection
-        select_PSR(&selection);
 
-        //Waits for push before sending selection
-        navswitch_update();
-        while (!navswitch_push_event_p(NAVSWITCH_PUSH)) {
-            navswitch_update();
+    receive_opponent(handshake, transport);
 
-            //Receives opponent's selection if necessary
-            if (!received) {
-                received = ir_serial_receive((uint8_t*)(&opponent));
-            }
+    //Waits for push before sending selection
+    if (*state == PSR_READY) {
+        if (!input_push_event_p(NAVSWITCH_PUSH)) {
+            return;
         }
-        ir_serial_transmit(selection);
+        handshake->unsent = 1;
+        *state = PSR_RESULT;
+    }
 
-        //If data not received, wait until it is
-        while (!received) {
-            received = ir_serial_receive((uint8_t*)(&opponent));
-        }
+    //Sent again on the next tick if the outbox is full
+    if (handshake->unsent) {
+        handshake->unsent = !transport_send(transport, PACKET_MATCH,
+                                            PACKET_MATCH(MATCH_CHOICE, handshake->selection));
+    }
+
+    //Waits until the selection is sent and the opponent's has arrived, so
+    //the opponent is never left waiting on this board's
+    if (handshake->unsent || !handshake->received) {
+        return;
+    }
 
-        //Determine winner, then either restart, or change game state appropriately
-        check_winner(selection, opponent, &restart, state);
+    //Determine winner, then either restart, or change game state appropriately
+    check_winner(handshake->selection, handshake->opponent, &restart, state);
+    if (restart) {
+        *handshake = (PSR_Handshake){0};
+        *state = PSR_SELECT;
+    } else {
+        anim_play(*state == BALL_SELECT ? &animation_WIN : &animation_LOSE);
     }
 }
 
-/** Sends projectile data after converting appropriately for opponents display
-    @param projectile Projectile object to send */
-void send_projectile(Projectile* projectile)
+/** Converts projectile data appropriately for opponents display
+    @param projectile Projectile object to convert */
+void turn_projectile(Projectile* projectile)
 {
-    //Convert projectile data for opponents display.
-    projectile->x = 6 - projectile->x;
+    projectile->x = FIXED(COURT_MAX_X) - projectile->x;
     projectile->delta_x *= -1;
     projectile->delta_y *= -1;
+    projectile->heading = SERVE_COUNT - 1 - projectile->heading;
+}
 
-    //Transmits projectile data in order.
-    ir_serial_transmit(projectile->x);
-    ir_serial_transmit(projectile->y);
-    ir_serial_transmit(projectile->delta_x);
-    ir_serial_transmit(projectile->delta_y);
-}
-
-/** Waits for projectile data from opponent. Allows nav_switch updates while waiting
-    @param projectile Projectile object to store data to
-    @param paddle Paddle object to move while waiting
-    @param state Game state. Change to GAME_ON when data received */
-void wait_for_data(Projectile* projectile, Paddle* paddle, State* state)
-{
-    int8_t* address;
-    for (int8_t i = 0; i < 4; i++) {
-        //Specifies what projectile data should be received.
-        switch (i) {
-            case 0:
-                address = &projectile->x;
-                break;
-            case 1:
-                address = &projectile->y;
-                break;
-            case 2:
-                address = &projectile->delta_x;
-                break;
-            case 3:
-                address = &projectile->delta_y;
-                break;
+/** Sends projectile data after converting appropriately for opponents display
+    @param transport Transport to send it on
+    @param projectile Projectile object to send
+    @param id Its ID in the ball pool */
+void send_projectile(Transport* transport, Projectile* projectile, uint8_t id)
+{
+    turn_projectile(projectile);
+    if (transport_send(transport, PACKET_PROJECTILE, packet_projectile_payload(projectile, id))) {
+        TRACE_EVENT(TRACE_SEND, TRACE_HANDOFF(id, (transport->next_seq - 1) & PACKET_SEQ_MASK));
+    } else {
+        TRACE_EVENT(TRACE_SEND, TRACE_HANDOFF(id, TRACE_NO_SEQ));
+    }
+}
+
+/** Moves a received ball on by the time it spent in flight, so it keeps
+    the same apparent speed across the court boundary. The sender transmits
+    the frame bytes back to back, so the gap between the last two is one
+    byte's airtime, and the ball crossed the boundary PACKET_SIZE airtimes
+    before the frame completed. A retransmitted frame is older than that,
+    but is already late, so is not rushed further.
+    @param projectile Projectile object just received
+    @param byte_gap Timer ticks between the last two frame bytes arriving */
+static void catch_up(Projectile* projectile, timer_tick_t byte_gap)
+{
+    uint8_t steps = MAX_CATCH_UP_STEPS;
+    //Gaps long enough to reach the cap are cut off first, so this fits 16 bits
+    if (byte_gap < MAX_CATCH_UP_STEPS * BALL_PERIOD / PACKET_SIZE) {
+        steps = (byte_gap * PACKET_SIZE + BALL_PERIOD / 2) / BALL_PERIOD;
+    }
+    projectile_advance(projectile, steps);
+}
+
+/** Takes every ball that has arrived from the opponent into play, without
+    blocking. Call once per tick while WAITING or GAME_ON, after transport_poll().
+    A ball whose slot is still in use is dropped.
+    @param transport Transport the balls arrive on
+    @param pool Ball pool to put them in
+    @param state Game state. Change to GAME_ON when a ball is received */
+void wait_for_data(Transport* transport, Ball_Pool* pool, State* state)
+{
+    uint16_t payload;
+    timer_tick_t byte_gap;
+    Projectile projectile;
+    uint8_t id;
+    while (transport_take(transport, PACKET_PROJECTILE, &payload, &byte_gap)) {
+        if (packet_unpack_projectile(payload, &projectile, &id)) {
+            catch_up(&projectile, byte_gap);
+            if (ball_pool_put(pool, id, &projectile)) {
+                TRACE_EVENT(TRACE_RECEIVE, id);
+                *state = GAME_ON;
+            } else {
+                TRACE_EVENT(TRACE_RECEIVE, id | TRACE_DROPPED);
+            }
+        }
+    }
+}
+
+/** Packs this board's side of a saved match into a resume request.
+    @param match Saved match
+    @param reply 1 if answering the opponent's request
+    @return value of a MATCH_RESUME message */
+static uint16_t resume_value(const Match_Record* match, bool reply)
+{
+    return (match->serving ? RESUME_SERVING : 0) | (reply ? RESUME_REPLY : 0)
+           | (match->won & RESUME_WON_MASK);
+}
+
+/** Checks the opponent's side of a saved match agrees with this board's.
+    @param match This board's side of the match
+    @param value Value of the opponent's MATCH_RESUME message
+    @return 1 if the opponent serves when this board does not, and has
+    won the points this board has lost */
+static bool resume_agrees_p(const Match_Record* match, uint16_t value)
+{
+    return ((value & RESUME_SERVING) != 0) != match->serving
+           && (value & RESUME_WON_MASK) == match->lost;
+}
+
+/** Tells the opponent this board has missed, so both keep the score.
+    @param transport Transport to send it on
+    @param lost Points this board has lost in the match
+    @return 1 if it was queued, 0 if the outbox is full */
+bool send_point(Transport* transport, uint8_t lost)
+{
+    return transport_send(transport, PACKET_MATCH, PACKET_MATCH(MATCH_POINT, lost));
+}
+
+/** Takes match messages from the opponent without blocking: a point it
+    has lost, a request to resume the match after it was reset, which
+    is answered with this board's side of the match if the two sides
+    agree, or a pairing nonce from an opponent that missed the pair
+    decided on, which is sent again.
+    Call once per tick during a match, after transport_poll().
+    @param transport Transport the messages arrive on
+    @param match This board's side of the match
+    @param pairing Pairing that decided who served first, if any
+    @param opponent_lost Set to the opponent's points lost when it misses
+    @return 1 if the opponent has just lost a point */
+bool receive_match(Transport* transport, const Match_Record* match, const Pairing* pairing,
+                   uint8_t* opponent_lost)
+{
+    uint16_t payload;
+    while (transport_take(transport, PACKET_MATCH, &payload, NULL)) {
+        uint16_t value = PACKET_MATCH_VALUE(payload);
+        if (PACKET_MATCH_KIND(payload) == MATCH_POINT) {
+            *opponent_lost = value;
+            return 1;
         }
+        if (PACKET_MATCH_KIND(payload) == MATCH_RESUME && !(value & RESUME_REPLY)
+            && resume_agrees_p(match, value)) {
+            transport_send(transport, PACKET_MATCH, PACKET_MATCH(MATCH_RESUME, resume_value(match, 1)));
+        }
+        //An opponent still pairing missed the pair this board decided on.
+        //Any other nonce is from a pairing this board took no part in
+        if (PACKET_MATCH_KIND(payload) == MATCH_PAIR && PACKET_PAIR_NONCE(value) == pairing->opponent) {
+            transport_send(transport, PACKET_MATCH, packet_pair_payload(pairing->nonce, pairing->opponent));
+        }
+    }
+    return 0;
+}
 
-        /*Waits for data to be written to specified location. 
-            Also allows paddle updates while waiting*/
-        while(ir_serial_receive((uint8_t*)address) != 1) {
-            tinygl_clear();
-            navswitch_update();
-            display_paddle(paddle);
-            update_paddle(paddle);
-            tinygl_update();
+/** Asks the opponent to carry on the saved match after a reset, without
+    blocking, repeating the request every RESUME_INTERVAL until answered.
+    The opponent answers whether it has also been reset or is still
+    playing, but only if its side of the match agrees with this board's.
+    Call once per tick in RESUME.
+    @param transport Transport to ask on
+    @param match Saved match
+    @param resend_at Timer tick to ask again, kept between calls
+    @param state BALL_SELECT or WAITING once both boards agree on who
+    serves and the score, or BEGIN if the player pushes to start afresh */
+void resume_match(Transport* transport, const Match_Record* match, timer_tick_t* resend_at, State* state)
+{
+    uint16_t payload;
+
+    if (input_push_event_p(NAVSWITCH_PUSH)) {
+        text_clear();
+        *state = BEGIN;
+        return;
+    }
+
+    //Asks again in case the first request met a board that was not listening
+    if (!transport_busy_p(transport) && (int16_t)(timer_get() - *resend_at) >= 0) {
+        transport_send(transport, PACKET_MATCH, PACKET_MATCH(MATCH_RESUME, resume_value(match, 0)));
+        *resend_at = timer_get() + RESUME_INTERVAL;
+    }
+
+    //Both sides must have the other serving, and the same score. A reply
+    //only comes from an opponent that found this board's request agreed
+    while (transport_take(transport, PACKET_MATCH, &payload, NULL)) {
+        uint16_t value = PACKET_MATCH_VALUE(payload);
+        if (PACKET_MATCH_KIND(payload) != MATCH_RESUME || !resume_agrees_p(match, value)) {
+            continue;
         }
+        if (value & RESUME_REPLY) {
+            text_clear();
+            framebuffer_show(FRAMEBUFFER_ALL_LAYERS);
+            *state = match->serving ? BALL_SELECT : WAITING;
+            return;
+        }
+        //The opponent was reset too, and waits for this board to agree
+        transport_send(transport, PACKET_MATCH, PACKET_MATCH(MATCH_RESUME, resume_value(match, 1)));
     }
+}
 
-    *state = GAME_ON;
-}
\ No newline at end of file
+/** Drops balls that arrive when none are wanted, e.g. those the opponent
+    was still playing when this board missed.
+    @param transport Transport the balls arrive on */
+void drop_projectiles(Transport* transport)
+{
+    uint16_t payload;
+    while (transport_take(transport, PACKET_PROJECTILE, &payload, NULL)) {
+    }
+}
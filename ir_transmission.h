@@ -13,11 +13,68 @@
 #include "projectile.h"
 #include "ir_transmission.h"
 #include "states.h"
-
-
-/** Selects paper, scissors or rock to determine starting player
-    @param selection Char address to store selected paper/scissors/rock*/
-void select_PSR(char* selection);
+#include "packet.h"
+#include "transport.h"
+#include "balls.h"
+#include "matchlog.h"
+#include "timer.h"
+
+#define RESUME_INTERVAL (TIMER_RATE / 2)  //timer ticks between requests to resume
+#define PAIR_INTERVAL (TIMER_RATE / 8)     //timer ticks between nonces sent while pairing
+
+
+//Defines the paper, scissors, rock handshake, kept between ticks
+typedef struct {
+    uint8_t choice;   //index into text_PSR_CHOICES being shown
+    char selection;   //own paper/scissors/rock, once chosen
+    char opponent;    //opponent's selection, once received
+    bool received;
+    bool unsent;      //1 while the selection is pushed but not yet sent
+} PSR_Handshake;
+
+//Defines the automatic pairing, kept between ticks
+typedef struct {
+    uint16_t seed;           //own random state, whose low bits are the nonce
+    uint8_t nonce;           //own nonce, sent to the opponent
+    uint8_t drawn;           //mask of own nonces drawn so far
+    uint8_t opponent;        //opponent's nonce, or PACKET_PAIR_NONE until heard
+    bool confirmed;          //1 if the opponent last sent opponent, having heard nonce
+    bool unsent;             //1 while nonce and opponent are not yet sent as a pair
+    timer_tick_t resend_at;  //timer tick to send both nonces again
+} Pairing;
+
+
+/** Starts pairing with the opponent, by sending it a random nonce.
+    Call on entering PAIRING.
+    @param pairing Pairing to start
+    @param transport Transport to send the nonce on
+    @param seed Source of the nonce, e.g. the timer when the player pushed */
+void start_pairing(Pairing* pairing, Transport* transport, uint16_t seed);
+
+
+/** Decides who serves without any input. Each board sends its own nonce
+    with the opponent's as last heard, and once it has sent the pair
+    (own, opponent) and heard the same pair back, the board with the
+    larger nonce serves. Equal nonces are drawn again, forgetting the
+    opponent's, until every nonce has tied, when it goes to the manual
+    handshake. Both nonces are sent again every PAIR_INTERVAL until
+    decided, in case a message was lost in a way the transport could not
+    see, and on the next tick if the outbox is full.
+    Pushing the navswitch, or an opponent that has gone to paper, scissors,
+    rock, switches to the manual handshake. Call once per tick in PAIRING.
+    @param pairing Pairing started by start_pairing()
+    @param handshake Handshake to keep an opponent's paper/scissors/rock in
+    @param transport Transport the nonces arrive on
+    @param state BALL_SELECT or WAITING once decided, or PSR_SELECT */
+void auto_pair(Pairing* pairing, PSR_Handshake* handshake, Transport* transport, State* state);
+
+
+/** Selects paper, scissors or rock to determine starting player.
+    Call once per tick in PSR_SELECT.
+    @param handshake Handshake to store the selection in
+    @param transport Transport the opponent's selection arrives on
+    @param state Changes to PSR_READY once a selection is made */
+void select_PSR(PSR_Handshake* handshake, Transport* transport, State* state);
 
 
 /** Helper function to check for winner of paper, scissors, rock.
@@ -28,21 +85,74 @@ void select_PSR(char* selection);
 void check_winner(char selection, char opponent, bool* restart, State* state);
 
 
-/** Uses paper, scissors, rock to determine starting player
+/** Uses paper, scissors, rock to determine starting player.
+    Call once per tick in PSR_READY and PSR_RESULT.
+    @param handshake Selection made, and what has arrived from the opponent
+    @param transport Transport to send the selection on
     @param state Game state to change depending on winner */
-void starting_player_select(State* state);
+void starting_player_select(PSR_Handshake* handshake, Transport* transport, State* state);
 
 
-/** Sends projectile data after converting appropriately for opponents display
-    @param projectile Projectile object to send */
-void send_projectile(Projectile* projectile);
+/** Converts projectile data appropriately for opponents display
+    @param projectile Projectile object to convert */
+void turn_projectile(Projectile* projectile);
 
 
-/** Waits for projectile data from opponent. Allows nav_switch updates while waiting
-    @param projectile Projectile object to store data to
-    @param paddle Paddle object to move while waiting
-    @param state Game state. Change to GAME_ON when data received */
-void wait_for_data(Projectile* projectile, Paddle* paddle, State* state);
+/** Sends projectile data after converting appropriately for opponents display
+    @param transport Transport to send it on
+    @param projectile Projectile object to send
+    @param id Its ID in the ball pool */
+void send_projectile(Transport* transport, Projectile* projectile, uint8_t id);
+
+
+/** Takes every ball that has arrived from the opponent into play, without
+    blocking. Call once per tick while WAITING or GAME_ON, after transport_poll().
+    A ball whose slot is still in use is dropped.
+    @param transport Transport the balls arrive on
+    @param pool Ball pool to put them in
+    @param state Game state. Change to GAME_ON when a ball is received */
+void wait_for_data(Transport* transport, Ball_Pool* pool, State* state);
+
+
+/** Tells the opponent this board has missed, so both keep the score.
+    @param transport Transport to send it on
+    @param lost Points this board has lost in the match
+    @return 1 if it was queued, 0 if the outbox is full */
+bool send_point(Transport* transport, uint8_t lost);
+
+
+/** Takes match messages from the opponent without blocking: a point it
+    has lost, a request to resume the match after it was reset, which
+    is answered with this board's side of the match if the two sides
+    agree, or a pairing nonce from an opponent that missed the pair
+    decided on, which is sent again.
+    Call once per tick during a match, after transport_poll().
+    @param transport Transport the messages arrive on
+    @param match This board's side of the match
+    @param pairing Pairing that decided who served first, if any
+    @param opponent_lost Set to the opponent's points lost when it misses
+    @return 1 if the opponent has just lost a point */
+bool receive_match(Transport* transport, const Match_Record* match, const Pairing* pairing,
+                   uint8_t* opponent_lost);
+
+
+/** Asks the opponent to carry on the saved match after a reset, without
+    blocking, repeating the request every RESUME_INTERVAL until answered.
+    The opponent answers whether it has also been reset or is still
+    playing, but only if its side of the match agrees with this board's.
+    Call once per tick in RESUME.
+    @param transport Transport to ask on
+    @param match Saved match
+    @param resend_at Timer tick to ask again, kept between calls
+    @param state BALL_SELECT or WAITING once both boards agree on who
+    serves and the score, or BEGIN if the player pushes to start afresh */
+void resume_match(Transport* transport, const Match_Record* match, timer_tick_t* resend_at, State* state);
+
+
+/** Drops balls that arrive when none are wanted, e.g. those the opponent
+    was still playing when this board missed.
+    @param transport Transport the balls arrive on */
+void drop_projectiles(Transport* transport);
 
 
 
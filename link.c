@@ -0,0 +1,35 @@
+/** @file link.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief The byte link between the two boards, over IR.
+*/
+
+#include <stdint.h>
+#include "system.h"
+#include "ir_serial.h"
+#include "input.h"
+#include "link.h"
+
+
+/** Starts the link. */
+void link_init(void)
+{
+    ir_serial_init();
+}
+
+
+/** Sends one byte to the other board.
+    @param data Byte to send */
+void link_send(uint8_t data)
+{
+    ir_serial_transmit(data);
+}
+
+
+/** Takes one byte from the other board, if one has arrived. Never waits.
+    @param data Address to store the byte received
+    @return 1 if a byte was received */
+bool link_receive(uint8_t* data)
+{
+    return input_ir_receive(data) == IR_SERIAL_OK;
+}
@@ -0,0 +1,35 @@
+/** @file link.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief The byte link between the two boards.
+
+    Every byte the game exchanges with the other board goes through here,
+    so ir_transmission.c does not depend on what carries it. On the board
+    the link is ir_serial, with bytes received through the input module so
+    they are recorded. The host build links the loopback links of
+    host/hw_shim.c in place of ir_serial; they can add latency, jitter,
+    lost bytes, bit flips and reordering.
+*/
+
+#ifndef LINK_H
+#define LINK_H
+
+#include <stdint.h>
+#include "system.h"
+
+
+/** Starts the link. */
+void link_init(void);
+
+
+/** Sends one byte to the other board.
+    @param data Byte to send */
+void link_send(uint8_t data);
+
+
+/** Takes one byte from the other board, if one has arrived. Never waits.
+    @param data Address to store the byte received
+    @return 1 if a byte was received */
+bool link_receive(uint8_t* data);
+
+#endif //LINK_H
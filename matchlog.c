@@ -0,0 +1,144 @@
+/** @file matchlog.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Wear-levelled log of the match in EEPROM, for resuming after a reset.
+*/
+
+#include <stdint.h>
+#include <avr/eeprom.h>
+#include "system.h"
+#include "matchlog.h"
+
+#define CRC_POLY 0x07
+#define CRC_BYTES (MATCHLOG_RECORD_SIZE - 1)
+
+//Bytes of a packed record
+enum {
+    FIELD_SEQ, FIELD_FLAGS, FIELD_LOST, FIELD_WON,
+    FIELD_POINTS_LOW, FIELD_POINTS_HIGH, FIELD_LONGEST, FIELD_CRC
+};
+
+//Bits of FIELD_FLAGS
+#define FLAG_IN_MATCH 0x01
+#define FLAG_SERVING 0x02
+#define FLAG_MODE_SHIFT 2
+#define FLAG_MODE_MASK 0x03
+#define FLAG_LEVEL_SHIFT 4
+#define FLAG_LEVEL_MASK 0x0F
+
+/** Record waiting to be written, and the one being written. */
+static uint8_t waiting[MATCHLOG_RECORD_SIZE];
+static bool waiting_p;
+static uint8_t bytes[MATCHLOG_RECORD_SIZE];
+static uint8_t next_byte = MATCHLOG_RECORD_SIZE; //nothing in progress
+
+/** Slot and sequence number of the next record written. */
+static uint8_t next_slot;
+static uint8_t next_seq;
+
+
+/** Calculates the CRC-8 of a record, seeded with MATCHLOG_VERSION so a
+    blank or differently laid out log is not read as a match.
+    @param record Packed record
+    @return 8-bit CRC of all but its last byte */
+static uint8_t crc8(const uint8_t record[MATCHLOG_RECORD_SIZE])
+{
+    uint8_t crc = MATCHLOG_VERSION;
+    for (uint8_t i = 0; i < CRC_BYTES; i++) {
+        crc ^= record[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = crc & 0x80 ? (crc << 1) ^ CRC_POLY : crc << 1;
+        }
+    }
+    return crc;
+}
+
+
+/** Finds the newest saved record, and carries on the log after it.
+    Call once at boot.
+    @param record Record to write to. Emptied if none is found
+    @return 1 if a saved record was found */
+bool matchlog_load(Match_Record* record)
+{
+    uint8_t slot_bytes[MATCHLOG_RECORD_SIZE];
+    bool found = 0;
+
+    *record = (Match_Record){0};
+    next_slot = 0;
+    next_seq = 0;
+    for (uint8_t slot = 0; slot < MATCHLOG_SLOTS; slot++) {
+        uintptr_t address = MATCHLOG_ADDRESS + slot * MATCHLOG_RECORD_SIZE;
+        for (uint8_t i = 0; i < MATCHLOG_RECORD_SIZE; i++) {
+            slot_bytes[i] = eeprom_read_byte((uint8_t*)(address + i));
+        }
+        if (slot_bytes[FIELD_CRC] != crc8(slot_bytes)) {
+            continue;
+        }
+        //Every good record is within MATCHLOG_SLOTS of the newest, so
+        //the sequence numbers compare correctly across a wrap
+        if (found && (int8_t)(slot_bytes[FIELD_SEQ] - next_seq) < 0) {
+            continue;
+        }
+        found = 1;
+        next_slot = (slot + 1) % MATCHLOG_SLOTS;
+        next_seq = slot_bytes[FIELD_SEQ] + 1;
+        record->in_match = slot_bytes[FIELD_FLAGS] & FLAG_IN_MATCH;
+        record->serving = (slot_bytes[FIELD_FLAGS] & FLAG_SERVING) != 0;
+        record->mode = slot_bytes[FIELD_FLAGS] >> FLAG_MODE_SHIFT & FLAG_MODE_MASK;
+        record->level = slot_bytes[FIELD_FLAGS] >> FLAG_LEVEL_SHIFT & FLAG_LEVEL_MASK;
+        record->lost = slot_bytes[FIELD_LOST];
+        record->won = slot_bytes[FIELD_WON];
+        record->points = slot_bytes[FIELD_POINTS_LOW] | (uint16_t)slot_bytes[FIELD_POINTS_HIGH] << 8;
+        record->longest = slot_bytes[FIELD_LONGEST];
+    }
+    return found;
+}
+
+
+/** Queues a record to be appended to the log, replacing any record
+    still waiting that matchlog_drain() has not started.
+    @param record Record to save */
+void matchlog_save(const Match_Record* record)
+{
+    waiting[FIELD_FLAGS] = (record->in_match ? FLAG_IN_MATCH : 0)
+                           | (record->serving ? FLAG_SERVING : 0)
+                           | (record->mode & FLAG_MODE_MASK) << FLAG_MODE_SHIFT
+                           | (record->level & FLAG_LEVEL_MASK) << FLAG_LEVEL_SHIFT;
+    waiting[FIELD_LOST] = record->lost;
+    waiting[FIELD_WON] = record->won;
+    waiting[FIELD_POINTS_LOW] = record->points & 0xFF;
+    waiting[FIELD_POINTS_HIGH] = record->points >> 8;
+    waiting[FIELD_LONGEST] = record->longest;
+    waiting_p = 1;
+}
+
+
+/** Writes at most one byte of the waiting record to EEPROM, when EEPROM
+    is ready, so it never stalls the caller. */
+void matchlog_drain(void)
+{
+    if (!eeprom_is_ready()) {
+        return;
+    }
+
+    //Starts the waiting record in the next slot, once the last is written
+    if (next_byte == MATCHLOG_RECORD_SIZE) {
+        if (!waiting_p) {
+            return;
+        }
+        for (uint8_t i = 0; i < MATCHLOG_RECORD_SIZE; i++) {
+            bytes[i] = waiting[i];
+        }
+        bytes[FIELD_SEQ] = next_seq++;
+        bytes[FIELD_CRC] = crc8(bytes);
+        waiting_p = 0;
+        next_byte = 0;
+    }
+
+    uintptr_t address = MATCHLOG_ADDRESS + next_slot * MATCHLOG_RECORD_SIZE + next_byte;
+    eeprom_write_byte((uint8_t*)address, bytes[next_byte]);
+    next_byte++;
+    if (next_byte == MATCHLOG_RECORD_SIZE) {
+        next_slot = (next_slot + 1) % MATCHLOG_SLOTS;
+    }
+}
@@ -0,0 +1,61 @@
+/** @file matchlog.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Wear-levelled log of the match in EEPROM, for resuming after a reset.
+
+    The match is saved after every point as a MATCHLOG_RECORD_SIZE byte
+    record, appended to a ring of MATCHLOG_SLOTS slots at the top of EEPROM,
+    so each slot is only written once every MATCHLOG_SLOTS points. A record
+    is a sequence number, the packed match and a CRC-8 of both. On boot the
+    newest slot with a good CRC is the saved match; a record cut short by
+    a reset fails its CRC, and the one before it is used instead.
+
+    Records are written a byte at a time by matchlog_drain(), which never
+    waits for EEPROM. Only the newest record waiting is kept, so saving
+    faster than EEPROM can keep up skips records rather than stalling.
+*/
+
+#ifndef MATCHLOG_H
+#define MATCHLOG_H
+
+#include <stdint.h>
+#include <avr/io.h>
+#include "system.h"
+
+#define MATCHLOG_VERSION 1
+#define MATCHLOG_RECORD_SIZE 8
+#define MATCHLOG_SLOTS 32
+#define MATCHLOG_SIZE (MATCHLOG_RECORD_SIZE * MATCHLOG_SLOTS)
+#define MATCHLOG_ADDRESS (E2END + 1 - MATCHLOG_SIZE)
+
+//Defines the saved match, and stats kept across matches
+typedef struct {
+    bool in_match;     //1 while a match is being played
+    bool serving;      //1 if this board serves the next point
+    uint8_t mode;      //Game_Mode of the match
+    uint8_t level;     //Level of this board's court
+    uint8_t lost;      //points lost by this board in the match
+    uint8_t won;       //points lost by the opponent in the match
+    uint16_t points;   //points played in every match
+    uint8_t longest;   //most returns by this board in one point, in every match
+} Match_Record;
+
+
+/** Finds the newest saved record, and carries on the log after it.
+    Call once at boot.
+    @param record Record to write to. Emptied if none is found
+    @return 1 if a saved record was found */
+bool matchlog_load(Match_Record* record);
+
+
+/** Queues a record to be appended to the log, replacing any record
+    still waiting that matchlog_drain() has not started.
+    @param record Record to save */
+void matchlog_save(const Match_Record* record);
+
+
+/** Writes at most one byte of the waiting record to EEPROM, when EEPROM
+    is ready, so it never stalls the caller. */
+void matchlog_drain(void);
+
+#endif //MATCHLOG_H
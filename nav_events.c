@@ -0,0 +1,121 @@
+/** @file nav_events.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Interrupt-driven, debounced navswitch events.
+*/
+
+#include <stdint.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "system.h"
+#include "navswitch.h"
+#include "nav_events.h"
+
+#define NAVSWITCH_BUTTONS (NAVSWITCH_PUSH + 1)
+
+/*Stops the compiler moving queue reads and writes across the head and
+    tail updates that hand each entry between the interrupt and the game*/
+#define MEMORY_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+/** Queue of events. Only the interrupt writes head and only the game
+    writes tail. */
+static Nav_Event queue[NAV_EVENTS_SIZE];
+static volatile uint8_t head;
+static volatile uint8_t tail;
+static volatile uint8_t dropped;
+
+/** Debounced state of each button, one bit per button. */
+static uint8_t buttons_down;
+
+/** Samples in a row that each button has disagreed with its state. */
+static uint8_t disagreements[NAVSWITCH_BUTTONS];
+
+static uint16_t samples;
+static uint8_t prescale;
+
+
+/** Adds an event to the queue, or counts it as dropped if full.
+    @param button Button that changed
+    @param pressed 1 if it was pressed */
+static void queue_event(uint8_t button, bool pressed)
+{
+    uint8_t next = (head + 1) & (NAV_EVENTS_SIZE - 1);
+    if (next == tail) {
+        dropped++;
+        return;
+    }
+    queue[head].button = button;
+    queue[head].pressed = pressed;
+    queue[head].time = samples;
+    MEMORY_BARRIER();
+    head = next;
+}
+
+
+/** Samples and debounces every button, at NAV_SAMPLE_RATE. The navswitch
+    driver is only used from here, so it is never re-entered. */
+ISR(TIMER0_COMPA_vect)
+{
+    if (++prescale < NAV_SAMPLE_DIVISOR) {
+        return;
+    }
+    prescale = 0;
+    samples++;
+
+    navswitch_update();
+    for (uint8_t button = 0; button < NAVSWITCH_BUTTONS; button++) {
+        uint8_t mask = 1 << button;
+        bool down = navswitch_down_p(button);
+        if (down == !!(buttons_down & mask)) {
+            disagreements[button] = 0;
+        } else if (++disagreements[button] >= NAV_DEBOUNCE_SAMPLES) {
+            disagreements[button] = 0;
+            buttons_down ^= mask;
+            queue_event(button, down);
+        }
+    }
+}
+
+
+/** Starts sampling the navswitch, with an empty queue. */
+void nav_events_init(void)
+{
+    head = 0;
+    tail = 0;
+    dropped = 0;
+    buttons_down = 0;
+    navswitch_init();
+
+    //Timer 0 free running at F_CPU / 8, interrupting once per lap
+    TCCR0A = 0;
+    TCCR0B = _BV(CS01);
+    OCR0A = 0;
+    TIMSK0 |= _BV(OCIE0A);
+    sei();
+}
+
+
+/** Takes the events queued since the last call, oldest first.
+    @param events Array to copy the events into
+    @param size Most events to take
+    @return number of events taken */
+uint8_t nav_events_take(Nav_Event* events, uint8_t size)
+{
+    uint8_t count = 0;
+    uint8_t end = head;
+    MEMORY_BARRIER();
+    while (count < size && tail != end) {
+        events[count++] = queue[tail];
+        MEMORY_BARRIER();
+        tail = (tail + 1) & (NAV_EVENTS_SIZE - 1);
+    }
+    return count;
+}
+
+
+/** Returns the number of events lost because the queue was full.
+    @return events dropped */
+uint8_t nav_events_dropped(void)
+{
+    return dropped;
+}
@@ -0,0 +1,53 @@
+/** @file nav_events.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Interrupt-driven, debounced navswitch events.
+
+    A timer interrupt samples the navswitch at NAV_SAMPLE_RATE, whatever
+    the game is doing, and debounces each button: a button only changes
+    state after NAV_DEBOUNCE_SAMPLES samples in a row agree. Each change
+    goes into a small queue as a press or release event stamped with the
+    sample count, so presses made while the game is busy are kept until
+    it next reads the queue. The interrupt only ever writes the head of
+    the queue and the game only its tail, both single bytes, so neither
+    side needs to lock the other out.
+
+    The sampling runs on timer/counter 0, free running at F_CPU / 8 as the
+    profiler expects, using its compare match A interrupt.
+*/
+
+#ifndef NAV_EVENTS_H
+#define NAV_EVENTS_H
+
+#include <stdint.h>
+#include "system.h"
+
+#define NAV_EVENTS_SIZE 16 //a power of two
+#define NAV_SAMPLE_DIVISOR 4
+#define NAV_SAMPLE_RATE (F_CPU / 8 / 256 / NAV_SAMPLE_DIVISOR)
+#define NAV_DEBOUNCE_SAMPLES 4
+
+//Defines one press or release of a navswitch button
+typedef struct {
+    uint8_t button;   //NAVSWITCH_NORTH, ..., NAVSWITCH_PUSH
+    bool pressed;     //1 for a press, 0 for a release
+    uint16_t time;    //sample count when it happened, at NAV_SAMPLE_RATE
+} Nav_Event;
+
+
+/** Starts sampling the navswitch, with an empty queue. */
+void nav_events_init(void);
+
+
+/** Takes the events queued since the last call, oldest first.
+    @param events Array to copy the events into
+    @param size Most events to take
+    @return number of events taken */
+uint8_t nav_events_take(Nav_Event* events, uint8_t size);
+
+
+/** Returns the number of events lost because the queue was full.
+    @return events dropped */
+uint8_t nav_events_dropped(void);
+
+#endif //NAV_EVENTS_H
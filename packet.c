@@ -0,0 +1,191 @@
+/** @file packet.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Compact, checksummed packets sent over IR.
+*/
+
+#include <stdint.h>
+#include "system.h"
+#include "packet.h"
+#include "projectile.h"
+#include "fixed.h"
+#include "geometry.h"
+
+#define CRC_POLY 0x07
+#define CRC_BITS 8
+#define DATA_BITS 16
+#define PAYLOAD_BITS 12
+#define SEQ_SHIFT PAYLOAD_BITS
+#define TAG_SHIFT (PAYLOAD_BITS + 2)
+#define PAYLOAD_MASK ((1 << PAYLOAD_BITS) - 1)
+#define FRAME_MASK 0xFFFFFFUL
+
+/*Ranges of the projectile fields. x is sent in quarter cells, or in half
+    or whole cells on courts too wide for quarters to fit; whole cells fit
+    any court geometry.h allows*/
+#define BALL_BITS (PAYLOAD_BITS - PACKET_BALL_ID_BITS)
+#define BALL_MASK ((1 << BALL_BITS) - 1)
+#define X_FITS_P(shift) (((COURT_MAX_X << (shift)) + 1) * SERVE_COUNT * SPEED_LEVELS <= (1 << BALL_BITS))
+#define X_SHIFT (FIXED_SHIFT - (X_FITS_P(2) ? 2 : X_FITS_P(1) ? 1 : 0))
+#define X_VALUES ((COURT_MAX_X << (FIXED_SHIFT - X_SHIFT)) + 1)
+#define BALL_VALUES (X_VALUES * SERVE_COUNT * SPEED_LEVELS)
+
+
+/** Calculates the CRC-8 of the top 16 bits of a frame.
+    @param data Tag, sequence number and payload bits
+    @return 8-bit CRC */
+static uint8_t crc8(uint16_t data)
+{
+    uint8_t crc = PACKET_VERSION ^ (COURT_GEOMETRY << 4);
+    for (int8_t i = DATA_BITS - 1; i >= 0; i--) {
+        uint8_t bit = ((data >> i) & 1) ^ (crc >> (CRC_BITS - 1));
+        crc <<= 1;
+        if (bit) {
+            crc ^= CRC_POLY;
+        }
+    }
+    return crc;
+}
+
+
+/** Works out the check bits of a pairing value.
+    @param value Both nonces, in their places in the value
+    @return 4 check bits */
+static uint8_t pair_check(uint16_t value)
+{
+    uint8_t bits = value >> PACKET_PAIR_SEEN_SHIFT;
+    return (bits ^ bits >> 4 ^ 0x9) & 0xF;
+}
+
+
+/** Checks a payload is one its packet type can carry. A frame that passes
+    the CRC can still be made of the ends of two frames after a lost byte,
+    and this rejects most of those too.
+    @param type Packet type
+    @param payload 12-bit payload
+    @return 1 if the payload is valid for the type */
+static bool payload_valid_p(uint8_t type, uint16_t payload)
+{
+    switch (type) {
+        case PACKET_PROJECTILE:
+            return (payload & BALL_MASK) < BALL_VALUES;
+        case PACKET_MATCH:
+            if (PACKET_MATCH_KIND(payload) == MATCH_CHOICE) {
+                return payload == 'P' || payload == 'S' || payload == 'R';
+            }
+            if (PACKET_MATCH_KIND(payload) == MATCH_PAIR) {
+                //A board never sends, or hears, a nonce equal to its own
+                uint16_t value = PACKET_MATCH_VALUE(payload);
+                return (value & 0xF) == pair_check(value) && PACKET_PAIR_NONCE(value) != PACKET_PAIR_NONE
+                       && PACKET_PAIR_NONCE(value) != PACKET_PAIR_SEEN(value);
+            }
+            if (PACKET_MATCH_KIND(payload) == MATCH_POINT) {
+                //Points lost are kept in a byte
+                return PACKET_MATCH_VALUE(payload) <= UINT8_MAX;
+            }
+            return PACKET_MATCH_KIND(payload) < MATCH_KINDS;
+        case PACKET_ACK:
+            return payload < ACK_KINDS;
+        default:
+            return 0;
+    }
+}
+
+
+/** Builds a frame from a packet.
+    @param packet Packet to frame
+    @return 24-bit frame to transmit */
+uint32_t packet_frame(const Packet* packet)
+{
+    uint16_t data = ((uint16_t)packet->type << TAG_SHIFT)
+                    | ((uint16_t)(packet->seq & PACKET_SEQ_MASK) << SEQ_SHIFT)
+                    | (packet->payload & PAYLOAD_MASK);
+    return ((uint32_t)data << CRC_BITS) | crc8(data);
+}
+
+
+/** Packs a projectile into a payload.
+    @param projectile Projectile to pack
+    @param id Ball ID, below 1 << PACKET_BALL_ID_BITS
+    @return 12-bit payload */
+uint16_t packet_projectile_payload(const Projectile* projectile, uint8_t id)
+{
+    uint16_t payload = (projectile->x + (1 << (X_SHIFT - 1))) >> X_SHIFT;
+    payload = payload * SERVE_COUNT + projectile->heading;
+    payload = payload * SPEED_LEVELS + projectile->speed;
+    return (uint16_t)id << BALL_BITS | payload;
+}
+
+
+/** Packs a pair of pairing nonces into a MATCH_PAIR payload, with its check.
+    @param nonce Own nonce, below PACKET_PAIR_NONE
+    @param seen Opponent's nonce as last heard, or PACKET_PAIR_NONE
+    @return 12-bit payload */
+uint16_t packet_pair_payload(uint8_t nonce, uint8_t seen)
+{
+    uint16_t value = (uint16_t)nonce << PACKET_PAIR_NONCE_SHIFT | (uint16_t)seen << PACKET_PAIR_SEEN_SHIFT;
+    return PACKET_MATCH(MATCH_PAIR, value | pair_check(value));
+}
+
+
+/** Unpacks a projectile payload, rejecting values out of range.
+    @param payload Payload of a PACKET_PROJECTILE packet
+    @param projectile Projectile to write to. Untouched if the payload is rejected
+    @param id Address to store the ball ID
+    @return 1 if the payload was a valid projectile */
+bool packet_unpack_projectile(uint16_t payload, Projectile* projectile, uint8_t* id)
+{
+    *id = payload >> BALL_BITS;
+    payload &= BALL_MASK;
+    if (payload >= BALL_VALUES) {
+        return 0;
+    }
+
+    uint8_t speed = payload % SPEED_LEVELS;
+    payload /= SPEED_LEVELS;
+    uint8_t heading = payload % SERVE_COUNT;
+    projectile->x = (fixed_t)(payload / SERVE_COUNT) << X_SHIFT;
+    projectile->y = FIXED(COURT_MAX_Y);
+    projectile_aim(projectile, heading, speed, 1);
+    return 1;
+}
+
+
+/** Empties a receiver, dropping any partly received frame.
+    @param receiver Address of the Packet_Receiver object. */
+void packet_receiver_reset(Packet_Receiver* receiver)
+{
+    receiver->frame = 0;
+    receiver->received = 0;
+}
+
+
+/** Feeds one received byte to a receiver. Bytes slide through a three
+    byte window until it holds a valid frame, so a lost or corrupt byte
+    only costs the frame it was in. Frames whose payload does not fit
+    their type are rejected as well.
+    @param receiver Address of the Packet_Receiver object
+    @param data Byte received
+    @param packet Packet to write to once a whole valid frame has arrived
+    @return 1 if the byte completed a valid frame */
+bool packet_receiver_push(Packet_Receiver* receiver, uint8_t data, Packet* packet)
+{
+    receiver->frame = ((receiver->frame << 8) | data) & FRAME_MASK;
+    if (receiver->received < PACKET_SIZE) {
+        receiver->received++;
+    }
+    if (receiver->received < PACKET_SIZE) {
+        return 0;
+    }
+
+    uint16_t bits = receiver->frame >> CRC_BITS;
+    if ((receiver->frame & 0xFF) != crc8(bits)
+        || !payload_valid_p(bits >> TAG_SHIFT, bits & PAYLOAD_MASK)) {
+        return 0;
+    }
+    packet->type = bits >> TAG_SHIFT;
+    packet->seq = (bits >> SEQ_SHIFT) & PACKET_SEQ_MASK;
+    packet->payload = bits & PAYLOAD_MASK;
+    packet_receiver_reset(receiver);
+    return 1;
+}
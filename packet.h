@@ -0,0 +1,151 @@
+/** @file packet.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Compact, checksummed packets sent over IR.
+
+    A packet is one 24-bit frame, sent high byte first:
+
+        bits 23-22  type tag
+        bits 21-20  sequence number
+        bits 19-8   payload
+        bits 7-0    CRC-8 (x^8 + x^2 + x + 1) of bits 23-8
+
+    The CRC is seeded with PACKET_VERSION and the court geometry, so boards
+    running a different packet format or court size reject each other's
+    frames instead of misreading them.
+    A projectile payload packs x in quarter cells (0-24), the heading and
+    the speed level in mixed radix in its low 10 bits, which needs 875 of
+    their 1024 values, and the ball's ID in the pool in its top 2 bits.
+    Courts wider than the UCFK4's send x more coarsely, to fit.
+    The receiver starts the ball on its top row moving down.
+    A match payload holds its kind in its top 2 bits and a value in its
+    low 10: the 'R', 'P' or 'S' chosen in the handshake, the sender's
+    points lost so far, who serves and the points it has won when
+    resuming, or a pairing nonce. A pairing value holds the sender's
+    nonce in bits 9-7, the opponent's nonce as the sender last heard it
+    (or PACKET_PAIR_NONE) in bits 6-4 and a check of both in bits 3-0, so
+    each message names the whole pair it was sent for, and any 10 bits
+    would not pass for one.
+    An ACK carries the sequence number of the packet it acknowledges, and
+    a payload of ACK_MESSAGE. A board just reset sends an ACK with a
+    payload of ACK_SYNC, so the other board forgets the sequence numbers
+    it has delivered, and answers it with ACK_SYNCED.
+*/
+
+#ifndef PACKET_H
+#define PACKET_H
+
+#include <stdint.h>
+#include "system.h"
+#include "projectile.h"
+
+#define PACKET_VERSION 7
+#define PACKET_SIZE 3
+#define PACKET_SEQ_MASK 0x3
+#define PACKET_BALL_ID_BITS 2
+#define PACKET_MATCH_SHIFT 10
+#define PACKET_PAIR_NONCE_BITS 3
+#define PACKET_PAIR_NONCE_SHIFT 7
+#define PACKET_PAIR_SEEN_SHIFT 4
+#define PACKET_PAIR_NONCE_MASK ((1 << PACKET_PAIR_NONCE_BITS) - 1)
+#define PACKET_PAIR_NONE PACKET_PAIR_NONCE_MASK  //no nonce heard yet, never drawn
+
+/** Builds a match payload from its kind and value. */
+#define PACKET_MATCH(kind, value) ((uint16_t)(kind) << PACKET_MATCH_SHIFT | (value))
+
+/** Takes the kind of a match payload. */
+#define PACKET_MATCH_KIND(payload) ((payload) >> PACKET_MATCH_SHIFT)
+
+/** Takes the value of a match payload. */
+#define PACKET_MATCH_VALUE(payload) ((payload) & ((1 << PACKET_MATCH_SHIFT) - 1))
+
+/** Takes the sender's nonce from the value of a MATCH_PAIR payload. */
+#define PACKET_PAIR_NONCE(value) ((value) >> PACKET_PAIR_NONCE_SHIFT & PACKET_PAIR_NONCE_MASK)
+
+/** Takes the nonce the sender last heard from the value of a MATCH_PAIR payload. */
+#define PACKET_PAIR_SEEN(value) ((value) >> PACKET_PAIR_SEEN_SHIFT & PACKET_PAIR_NONCE_MASK)
+
+//Defines the packet types. 0 is never sent, so a blank frame is rejected.
+typedef enum {
+    PACKET_NONE = 0,
+    PACKET_PROJECTILE,
+    PACKET_MATCH,
+    PACKET_ACK
+} Packet_Type;
+
+//Defines the kinds of match message
+typedef enum {
+    MATCH_CHOICE = 0,  //paper, scissors or rock
+    MATCH_POINT,       //the sender missed, value is its points lost
+    MATCH_RESUME,      //the sender's saved match, after a reset
+    MATCH_PAIR,        //the sender's pairing nonce, and the opponent's it has heard
+    MATCH_KINDS
+} Match_Kind;
+
+//Defines the kinds of ACK, by payload
+typedef enum {
+    ACK_MESSAGE = 0,  //acknowledges the message with the same sequence number
+    ACK_SYNC,         //the sender was reset, and numbers its messages afresh
+    ACK_SYNCED,       //answers ACK_SYNC
+    ACK_KINDS
+} Ack_Kind;
+
+//Defines the fields of a packet
+typedef struct {
+    uint8_t type;
+    uint8_t seq;
+    uint16_t payload;
+} Packet;
+
+//Defines a resumable receiver, holding a partly received frame between ticks
+typedef struct {
+    uint32_t frame;
+    uint8_t received;
+    uint16_t byte_time;  //timer tick the last byte arrived, kept by the caller
+} Packet_Receiver;
+
+
+/** Builds a frame from a packet.
+    @param packet Packet to frame
+    @return 24-bit frame to transmit */
+uint32_t packet_frame(const Packet* packet);
+
+
+/** Packs a projectile into a payload.
+    @param projectile Projectile to pack
+    @param id Ball ID, below 1 << PACKET_BALL_ID_BITS
+    @return 12-bit payload */
+uint16_t packet_projectile_payload(const Projectile* projectile, uint8_t id);
+
+
+/** Packs a pair of pairing nonces into a MATCH_PAIR payload, with its check.
+    @param nonce Own nonce, below PACKET_PAIR_NONE
+    @param seen Opponent's nonce as last heard, or PACKET_PAIR_NONE
+    @return 12-bit payload */
+uint16_t packet_pair_payload(uint8_t nonce, uint8_t seen);
+
+
+/** Unpacks a projectile payload, rejecting values out of range.
+    @param payload Payload of a PACKET_PROJECTILE packet
+    @param projectile Projectile to write to. Untouched if the payload is rejected
+    @param id Address to store the ball ID
+    @return 1 if the payload was a valid projectile */
+bool packet_unpack_projectile(uint16_t payload, Projectile* projectile, uint8_t* id);
+
+
+/** Empties a receiver, dropping any partly received frame.
+    @param receiver Address of the Packet_Receiver object. */
+void packet_receiver_reset(Packet_Receiver* receiver);
+
+
+/** Feeds one received byte to a receiver. Bytes slide through a three
+    byte window until it holds a valid frame, so a lost or corrupt byte
+    only costs the frame it was in. Frames whose payload does not fit
+    their type are rejected as well.
+    @param receiver Address of the Packet_Receiver object
+    @param data Byte received
+    @param packet Packet to write to once a whole valid frame has arrived
+    @return 1 if the byte completed a valid frame */
+bool packet_receiver_push(Packet_Receiver* receiver, uint8_t data, Packet* packet);
+
+#endif //PACKET_H
@@ -4,24 +4,29 @@
     @brief Paddle object initialiser and driver
 */
 
-#include "tinygl.h"
 #include "system.h"
 #include "paddle.h"
 #include "navswitch.h"
+#include "input.h"
 #include <avr/io.h>
 #include <stdint.h>
 #include "projectile.h"
+#include "framebuffer.h"
+#include "geometry.h"
 
-/*Defines default paddle position and
-    time between paddle updates*/
-#define TOP_START_POINT tinygl_point(4, 4)
-#define BOTTOM_START_POINT tinygl_point(4, 2)
-#define PADDLE_TICKS 500
+/*Defines default paddle position, centred on the court's paddle row,
+    and the highest row its bottom can move to*/
+#define PADDLE_COL COURT_COL(0)
+#define BOTTOM_START ((COURT_WIDTH - PADDLE_LENGTH) / 2)
+#define TOP_START_POINT ((Paddle_Point){PADDLE_COL, BOTTOM_START + PADDLE_LENGTH - 1})
+#define BOTTOM_START_POINT ((Paddle_Point){PADDLE_COL, BOTTOM_START})
 #define BOTTOM_SCREEN 0
-#define TOP_SCREEN 4
+#define TOP_SCREEN (COURT_WIDTH - PADDLE_LENGTH)
 
-/** Counts the number of program ticks elapsed. */
-static uint64_t ticks = 0;
+//Hold-to-repeat timing in timer ticks
+#define MS_TICKS(ms) ((timer_tick_t)((uint32_t)TIMER_RATE * (ms) / 1000))
+#define REPEAT_DELAY_TICKS MS_TICKS(PADDLE_REPEAT_DELAY_MS)
+#define REPEAT_TICKS MS_TICKS(PADDLE_REPEAT_MS)
 
 /** Returns a newly initialised paddle object 
     @return Paddle object */
@@ -30,6 +35,8 @@ Paddle init_paddle(void)
     Paddle paddle;
     paddle.top_paddle = TOP_START_POINT;
     paddle.bottom_paddle = BOTTOM_START_POINT;
+    paddle.held = PADDLE_NOT_HELD;
+    paddle.repeat_at = 0;
     return paddle;
 }
 
@@ -37,7 +44,8 @@ Paddle init_paddle(void)
     @param paddle Address of Paddle object. */
 void display_paddle(Paddle* paddle) 
 {
-    tinygl_draw_line(paddle->top_paddle, paddle -> bottom_paddle, 1);
+    uint8_t length = paddle->top_paddle.y - paddle->bottom_paddle.y + 1;
+    framebuffer_column(LAYER_COURT, paddle->top_paddle.x, (((column_t)1 << length) - 1) << paddle->bottom_paddle.y);
 }
 
 /** Moves paddle up the screen one position 
@@ -60,25 +68,42 @@ void paddle_down(Paddle* paddle)
     }
 }
 
-/** Updates the paddle position in real-time 
-    @param paddle Address of Paddle object. */
-void update_paddle(Paddle* paddle) 
+/** Moves the paddle on a North or South press, or again while held.
+    Called after every input_update().
+    @param paddle Address of Paddle object.
+    @param now Current timer tick */
+void update_paddle(Paddle* paddle, timer_tick_t now) 
 {
-    ticks++;
-    if (ticks >= PADDLE_TICKS) {
-        if (navswitch_down_p(NAVSWITCH_NORTH)) {
-            paddle_up(paddle);
-        } else if (navswitch_down_p(NAVSWITCH_SOUTH)) {
-            paddle_down(paddle);
+    if (input_push_event_p(NAVSWITCH_NORTH)) {
+        paddle->held = NAVSWITCH_NORTH;
+        paddle->repeat_at = now + REPEAT_DELAY_TICKS;
+    } else if (input_push_event_p(NAVSWITCH_SOUTH)) {
+        paddle->held = NAVSWITCH_SOUTH;
+        paddle->repeat_at = now + REPEAT_DELAY_TICKS;
+    } else if (paddle->held == PADDLE_NOT_HELD || !input_down_p(paddle->held)) {
+        paddle->held = PADDLE_NOT_HELD;
+        return;
+    } else if ((int16_t)(now - paddle->repeat_at) < 0) {
+        return;
+    } else {
+        //Repeats keep to their own beat, unless held through a menu long past it
+        if ((int16_t)(now - paddle->repeat_at) >= REPEAT_TICKS) {
+            paddle->repeat_at = now;
         }
-        ticks = 0;
+        paddle->repeat_at += REPEAT_TICKS;
+    }
+
+    if (paddle->held == NAVSWITCH_NORTH) {
+        paddle_up(paddle);
+    } else {
+        paddle_down(paddle);
     }
 }
 
 /** Fetch the coordinates of the top of the paddle 
     @param paddle Address of Paddle object.
     @return y-coordinate of the top of the paddle.*/
-tinygl_coord_t get_paddle_top(Paddle* paddle) 
+int8_t get_paddle_top(Paddle* paddle) 
 {
     return paddle->top_paddle.y;
 }
@@ -86,7 +111,7 @@ tinygl_coord_t get_paddle_top(Paddle* paddle)
 /** Fetch the coordinates of the top of the paddle 
     @param paddle Address of Paddle object.
     @return y-coordinate of the bottom of the paddle.*/
-tinygl_coord_t get_paddle_bottom(Paddle*paddle) 
+int8_t get_paddle_bottom(Paddle*paddle) 
 {
     return paddle->bottom_paddle.y;
 }
@@ -4,20 +4,41 @@
     @brief Paddle object initialiser and driver
     
     This module initialises the paddles as well as dictates paddle 
-    control. Paddles are drawn using the tinygl module. They are an object 
+    control. Paddles are drawn into the framebuffer. They are an object 
     composed of two points, top and bottom and a line is drawn between these 
     points forming a paddle. 
+
+    The paddle moves on the press of North or South itself, at the next
+    input poll, so taps are never missed between samples. Held, it moves
+    again after PADDLE_REPEAT_DELAY_MS and then every PADDLE_REPEAT_MS.
+    Both are in real time, measured on the system timer.
 */
 
 #ifndef PADDLE_H
 #define PADDLE_H
 
-#include "tinygl.h"
+#include "system.h"
+#include "timer.h"
+
+/*Hold-to-repeat timing in ms. PADDLE_REPEAT_MS is also the fastest the
+    paddle moves while held*/
+#define PADDLE_REPEAT_DELAY_MS 200
+#define PADDLE_REPEAT_MS 100
+
+#define PADDLE_NOT_HELD 0xFF
+
+//Defines a cell of the display, as column and row
+typedef struct {
+    int8_t x;
+    int8_t y;
+} Paddle_Point;
 
 //Defines a paddle with two edge co-ords
 typedef struct {
-    tinygl_point_t top_paddle;
-    tinygl_point_t bottom_paddle;
+    Paddle_Point top_paddle;
+    Paddle_Point bottom_paddle;
+    uint8_t held;             //NAVSWITCH_NORTH or NAVSWITCH_SOUTH while held, or PADDLE_NOT_HELD
+    timer_tick_t repeat_at;   //timer tick of the next move while held
 } Paddle;
 
 
@@ -41,20 +62,22 @@ void paddle_up(Paddle* paddle);
 void paddle_down(Paddle* paddle);
 
 
-/** Updates the paddle position in real-time 
-    @param paddle Address of Paddle object. */
-void update_paddle(Paddle* paddle);
+/** Moves the paddle on a North or South press, or again while held.
+    Called after every input_update().
+    @param paddle Address of Paddle object.
+    @param now Current timer tick */
+void update_paddle(Paddle* paddle, timer_tick_t now);
 
 
 /** Fetch the coordinates of the top of the paddle 
     @param paddle Address of Paddle object.
     @return y-coordinate of the top of the paddle.*/
-tinygl_coord_t get_paddle_top(Paddle* paddle);
+int8_t get_paddle_top(Paddle* paddle);
 
 
 /** Fetch the coordinates of the top of the paddle 
     @param paddle Address of Paddle object.
     @return y-coordinate of the bottom of the paddle.*/
-tinygl_coord_t get_paddle_bottom(Paddle* paddle);  
+int8_t get_paddle_bottom(Paddle* paddle);  
 
 #endif 
\ No newline at end of file
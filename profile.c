@@ -0,0 +1,213 @@
+/** @file profile.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Per-stage timing of the game tasks.
+*/
+
+#include <stdint.h>
+#include "system.h"
+#include "profile.h"
+
+#ifdef PROFILE
+#include "pacer.h"
+#include "framebuffer.h"
+#include "text.h"
+#include "navswitch.h"
+#include "input.h"
+
+#ifdef __AVR__
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#define PROFILE_PRESCALE 8
+#else
+#include <time.h>
+
+#define PROFILE_PRESCALE 1
+#endif
+
+#define TEXT_SIZE (9 + PROFILE_STAGES * 28 + 1)
+
+static Profile_Stats stats[PROFILE_STAGES];
+static uint8_t load;  //percent of the last load window spent in the game tasks
+
+static const char* const stage_names[PROFILE_STAGES] = {
+    "INPUT", "STATE", "PADDLE", "BALL", "DRAW", "SCAN"
+};
+
+#ifdef __AVR__
+/** High byte of the profiling clock, counted by timer 0 overflows. */
+static volatile uint8_t overflows;
+
+ISR(TIMER0_OVF_vect)
+{
+    overflows++;
+}
+#endif
+
+
+/** Starts the profiling clock and empties the stats. */
+void profile_init(void)
+{
+    for (uint8_t i = 0; i < PROFILE_STAGES; i++) {
+        stats[i] = (Profile_Stats){.min = (profile_count_t)-1};
+    }
+#ifdef __AVR__
+    //Timer 0 free running at F_CPU / 8, interrupting on overflow. The
+    //navswitch sampler shares it, on its compare match interrupt
+    TCCR0A = 0;
+    TCCR0B = _BV(CS01);
+    TIMSK0 |= _BV(TOIE0);
+    sei();
+#endif
+}
+
+
+/** Reads the profiling clock. A count is 8 CPU cycles on the board, or
+    1 ns on the host; profile_cycles() converts counts to cycles or ns.
+    @return clock count, wrapping at the width of profile_count_t */
+profile_count_t profile_now(void)
+{
+#ifdef __AVR__
+    uint8_t sreg = SREG;
+    cli();
+    uint8_t low = TCNT0;
+    uint8_t high = overflows;
+    //An overflow not yet serviced belongs to a low byte that has wrapped
+    if ((TIFR0 & _BV(TOV0)) && low < 128) {
+        high++;
+    }
+    SREG = sreg;
+    return (uint16_t)high << 8 | low;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (profile_count_t)((uint64_t)now.tv_sec * 1000000000 + now.tv_nsec);
+#endif
+}
+
+
+/** Adds one run of a stage to its stats.
+    @param stage Stage that ran
+    @param counts Clock counts it took */
+void profile_record(Profile_Stage stage, profile_count_t counts)
+{
+    Profile_Stats* stage_stats = &stats[stage];
+    uint32_t cycles = profile_cycles(counts);
+    uint8_t bucket = 0;
+
+    if (counts < stage_stats->min) {
+        stage_stats->min = counts;
+    }
+    if (counts > stage_stats->max) {
+        stage_stats->max = counts;
+    }
+    stage_stats->total += counts;
+    stage_stats->runs++;
+
+    while (bucket < PROFILE_BUCKETS - 1 && cycles >= (uint32_t)PROFILE_BUCKET_BASE << bucket) {
+        bucket++;
+    }
+    if (stage_stats->histogram[bucket] != UINT16_MAX) {
+        stage_stats->histogram[bucket]++;
+    }
+}
+
+
+/** Keeps the share of time the game tasks took, for profile_show().
+    @param percent Percent of the last load window */
+void profile_load(uint8_t percent)
+{
+    load = percent;
+}
+
+
+/** Returns the stats kept for a stage.
+    @param stage Stage to look up
+    @return address of its stats, in clock counts */
+const Profile_Stats* profile_stats(Profile_Stage stage)
+{
+    return &stats[stage];
+}
+
+
+/** Converts clock counts to cycles on the board, or to ns on the host.
+    @param counts Clock counts
+    @return cycles or ns */
+uint32_t profile_cycles(uint32_t counts)
+{
+    return counts * PROFILE_PRESCALE;
+}
+
+
+/** Returns a short name for a stage.
+    @param stage Stage to name
+    @return name, e.g. "BALL" */
+const char* profile_stage_name(Profile_Stage stage)
+{
+    return stage_names[stage];
+}
+
+
+/** Writes a number in decimal, without pulling in printf.
+    @param text Where to write
+    @param number Number to write
+    @return address just after the last digit */
+static char* append_number(char* text, uint32_t number)
+{
+    char digits[10];
+    uint8_t count = 0;
+    do {
+        digits[count++] = '0' + number % 10;
+        number /= 10;
+    } while (number);
+    while (count) {
+        *text++ = digits[--count];
+    }
+    return text;
+}
+
+
+/** Scrolls the load as "LOAD percent", then the stats for every stage as
+    "NAME min/avg/max", in cycles, across the matrix until the navswitch
+    is pushed. */
+void profile_show(void)
+{
+    static char text[TEXT_SIZE];
+    char* end = text;
+
+    for (const char* name = "LOAD "; *name; name++) {
+        *end++ = *name;
+    }
+    end = append_number(end, load);
+    *end++ = ' ';
+
+    for (uint8_t i = 0; i < PROFILE_STAGES; i++) {
+        const Profile_Stats* stage_stats = &stats[i];
+        if (stage_stats->runs == 0) {
+            continue;
+        }
+        for (const char* name = stage_names[i]; *name; name++) {
+            *end++ = *name;
+        }
+        *end++ = ' ';
+        end = append_number(end, profile_cycles(stage_stats->min));
+        *end++ = '/';
+        end = append_number(end, profile_cycles(stage_stats->total / stage_stats->runs));
+        *end++ = '/';
+        end = append_number(end, profile_cycles(stage_stats->max));
+        *end++ = ' ';
+    }
+    *end = '\0';
+
+    text_scroll(text);
+    input_update();
+    while (!input_push_event_p(NAVSWITCH_PUSH)) {
+        pacer_wait();
+        text_update();
+        framebuffer_scan();
+        input_update();
+    }
+    text_clear();
+}
+#endif
@@ -0,0 +1,117 @@
+/** @file profile.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Per-stage timing of the game tasks.
+
+    Built with PROFILE defined, PROFILE_START() and PROFILE_END() stamp a
+    fast clock around each stage of the game and keep the minimum, mean
+    and maximum time and a histogram for every stage. Without PROFILE the
+    macros are empty and nothing is compiled in.
+
+    On the board the clock is timer/counter 0 at F_CPU / 8, so times are
+    in CPU cycles to within 8 cycles; the system timer is too coarse for
+    this at 1024 cycles a tick, and a count wraps after 524288 cycles. On
+    the host the clock is in nanoseconds, and a count wraps after about 4 s.
+    Histogram bucket n counts stages that took under
+    PROFILE_BUCKET_BASE << n cycles (or ns); the last bucket counts the rest.
+    PROFILE_LOAD() keeps the share of each second the tasks took, as
+    timed by the system timer, to show with the stages on the board.
+*/
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include "system.h"
+
+#define PROFILE_BUCKETS 8
+#define PROFILE_BUCKET_BASE 128
+
+//Defines the profiled stages of the game tasks
+typedef enum {
+    PROFILE_INPUT,   //input_update()
+    PROFILE_STATE,   //game_state(), including IR polling
+    PROFILE_PADDLE,  //update_paddle()
+    PROFILE_BALL,    //ball_pool_step()
+    PROFILE_DRAW,    //display_paddle() and ball_pool_draw()
+    PROFILE_SCAN,    //framebuffer_scan()
+    PROFILE_STAGES
+} Profile_Stage;
+
+//Defines a profiling clock count: 16 bits of timer 0 on the board, and
+//32 bits of nanoseconds on the host
+#ifdef __AVR__
+typedef uint16_t profile_count_t;
+#else
+typedef uint32_t profile_count_t;
+#endif
+
+//Defines the times kept for one stage, in clock counts
+typedef struct {
+    profile_count_t min;
+    profile_count_t max;
+    uint32_t total;
+    uint32_t runs;
+    uint16_t histogram[PROFILE_BUCKETS];
+} Profile_Stats;
+
+#ifdef PROFILE
+
+#define PROFILE_START(stage) profile_count_t profile_start_##stage = profile_now()
+#define PROFILE_END(stage) profile_record(stage, profile_now() - profile_start_##stage)
+#define PROFILE_LOAD(percent) profile_load(percent)
+
+
+/** Starts the profiling clock and empties the stats. */
+void profile_init(void);
+
+
+/** Reads the profiling clock. A count is 8 CPU cycles on the board, or
+    1 ns on the host; profile_cycles() converts counts to cycles or ns.
+    @return clock count, wrapping at the width of profile_count_t */
+profile_count_t profile_now(void);
+
+
+/** Adds one run of a stage to its stats.
+    @param stage Stage that ran
+    @param counts Clock counts it took */
+void profile_record(Profile_Stage stage, profile_count_t counts);
+
+
+/** Keeps the share of time the game tasks took, for profile_show().
+    @param percent Percent of the last load window */
+void profile_load(uint8_t percent);
+
+
+/** Returns the stats kept for a stage.
+    @param stage Stage to look up
+    @return address of its stats, in clock counts */
+const Profile_Stats* profile_stats(Profile_Stage stage);
+
+
+/** Converts clock counts to cycles on the board, or to ns on the host.
+    @param counts Clock counts
+    @return cycles or ns */
+uint32_t profile_cycles(uint32_t counts);
+
+
+/** Returns a short name for a stage.
+    @param stage Stage to name
+    @return name, e.g. "BALL" */
+const char* profile_stage_name(Profile_Stage stage);
+
+
+/** Scrolls the load as "LOAD percent", then the stats for every stage as
+    "NAME min/avg/max", in cycles, across the matrix until the navswitch
+    is pushed. */
+void profile_show(void);
+
+#else
+
+#define PROFILE_START(stage)
+#define PROFILE_END(stage)
+#define PROFILE_LOAD(percent)
+
+#endif
+
+#endif //PROFILE_H
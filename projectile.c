@@ -3,24 +3,96 @@
     @date 16 October 2025
     @brief Projectile object initialiser and driver
     @note Co-ordinates in this file are transformed to make ball math more intuitive,
-            e.g., (x,y) in here -> (4 - y, 6 - x) 
+            e.g., (x,y) in here -> (COURT_COL(y), COURT_ROW(x)) on the display,
+            see geometry.h. Ball position and velocity
+            are Q8.8 fixed point, and are rounded to cells for display 
 */
 
 #include <stdint.h>
-#include "tinygl.h"
-#include "ledmat.h"
+#include <avr/pgmspace.h>
 #include "projectile.h"
-#include "pacer.h"
 #include "navswitch.h"
+#include "input.h"
 #include "paddle.h"
 #include "states.h"
-#include "ir_transmission.h"
-#include "pacer.h"
+#include "framebuffer.h"
+#include "geometry.h"
+#include "anim.h"
 
 #define MESSAGE_RATE 10
-#define SAD_FACE_WAIT_TIME 15000
-#define DEFAULT_X 3
+#define DEFAULT_X (COURT_MAX_X / 2)
 #define DEFAULT_Y 0
+#define PREVIEW_ON_MS 300
+#define PREVIEW_OFF_MS 200
+
+//Columns of the serve table
+enum {SERVE_DIRECTION_X, SERVE_DIRECTION_Y, SERVE_FIELDS};
+
+/** Direction of each heading, generated from serves.def. */
+static const int16_t serve_table[SERVE_COUNT][SERVE_FIELDS] PROGMEM = {
+#define SERVE(name, direction_x, direction_y, preview_dx, preview_y) \
+    {direction_x, direction_y},
+#include "serves.def"
+#undef SERVE
+};
+
+/*Display column pattern of court cell (x, y) in column col, and of the ball
+    at the serve spot plus a preview pixel, so the bitmaps below are
+    worked out at compile time. Preview pixels are all within the four
+    rows nearest the paddle, and the other columns are blank*/
+#define CELL_PATTERN(col, x, y) ((col) == COURT_COL(y) ? (column_t)1 << COURT_ROW(x) : 0)
+#define PREVIEW_PATTERN(col, x, y) (CELL_PATTERN(col, DEFAULT_X, DEFAULT_Y) | CELL_PATTERN(col, x, y))
+#define PREVIEW_BITMAP(x, y) { \
+    [COURT_COL(0)] = PREVIEW_PATTERN(COURT_COL(0), x, y), [COURT_COL(1)] = PREVIEW_PATTERN(COURT_COL(1), x, y), \
+    [COURT_COL(2)] = PREVIEW_PATTERN(COURT_COL(2), x, y), [COURT_COL(3)] = PREVIEW_PATTERN(COURT_COL(3), x, y)}
+
+/** Ball at the serve spot, alone and with the preview pixel of each heading. */
+static const column_t serve_ball_bitmap[FRAMEBUFFER_COLS] PROGMEM = PREVIEW_BITMAP(DEFAULT_X, DEFAULT_Y);
+static const column_t serve_preview_bitmaps[SERVE_COUNT][FRAMEBUFFER_COLS] PROGMEM = {
+#define SERVE(name, direction_x, direction_y, preview_dx, preview_y) \
+    PREVIEW_BITMAP(DEFAULT_X + (preview_dx), preview_y),
+#include "serves.def"
+#undef SERVE
+};
+
+/** Serve preview of each heading: its preview pixel blinks next to the ball. */
+static const Anim_Frame serve_preview_frames[SERVE_COUNT][2] PROGMEM = {
+#define SERVE(name, direction_x, direction_y, preview_dx, preview_y) \
+    {{serve_preview_bitmaps[name], ANIM_TICKS(PREVIEW_ON_MS)}, {serve_ball_bitmap, ANIM_TICKS(PREVIEW_OFF_MS)}},
+#include "serves.def"
+#undef SERVE
+};
+static const Animation serve_previews[SERVE_COUNT] PROGMEM = {
+#define SERVE(name, direction_x, direction_y, preview_dx, preview_y) \
+    {serve_preview_frames[name], 2, ANIM_LOOP},
+#include "serves.def"
+#undef SERVE
+};
+
+/*Outgoing heading after a paddle hit, by where on the paddle the ball hit
+    (-1 towards the top, 0 middle, 1 towards the bottom) and incoming heading.
+    Off-centre hits are sent away from the centre, middle hits keep their angle*/
+#define BOUNCE_OFFSETS 3
+#define BOUNCE_OFFSET_BIAS 1
+#define BOUNCE(offset, heading) ((offset) < 0 ? NW : (offset) > 0 ? NE : (heading))
+#define BOUNCE_ROW(offset) { \
+    BOUNCE(offset, WNW), BOUNCE(offset, NW), BOUNCE(offset, NNW), BOUNCE(offset, N), \
+    BOUNCE(offset, NNE), BOUNCE(offset, NE), BOUNCE(offset, ENE)}
+
+/** Outgoing heading for each (hit offset, incoming heading). */
+static const uint8_t bounce_table[BOUNCE_OFFSETS][SERVE_COUNT] PROGMEM = {
+    BOUNCE_ROW(-1), BOUNCE_ROW(0), BOUNCE_ROW(1)
+};
+
+
+/** Reads one field of the serve table.
+    @param position Serve to look up, must be below SERVE_COUNT
+    @param field SERVE_DIRECTION_X or SERVE_DIRECTION_Y
+    @return value of the field */
+static int16_t serve_lookup(Start_Position position, uint8_t field)
+{
+    return (int16_t)pgm_read_word(&serve_table[position][field]);
+}
 
 /** Initialises the Projectile object.
     @param position The starting coordinates of the ball
@@ -28,209 +100,120 @@
 Projectile projectile_init(Start_Position position)
 {
     Projectile projectile;
-    switch (position) {
-        /*Chooses from 1 of 7 pre-programmed directions, 
-            depending on starting compass direction*/
-        case WNW:
-            projectile.delta_x = -2;
-            projectile.delta_y = 1;
-            break;
-        case NW:
-            projectile.delta_x = -1;
-            projectile.delta_y = 1;
-            break;
-        case NNW:
-            projectile.delta_x = -1;
-            projectile.delta_y = 2;
-            break;
-        case N:
-            projectile.delta_x = 0;
-            projectile.delta_y = 1;
-            break;
-        case NNE:
-            projectile.delta_x = 1;
-            projectile.delta_y = 2;
-            break;
-        case NE:
-            projectile.delta_x = 1;
-            projectile.delta_y = 1;
-            break;
-        case ENE:
-            projectile.delta_x = 2;
-            projectile.delta_y = 1;
-            break;
-        default:
-            projectile.delta_x = 0;
-            projectile.delta_y = 1;
-            break;
+    if (position >= SERVE_COUNT) {
+        position = DEFAULT_SERVE;
     }
-    projectile.x = DEFAULT_X;
-    projectile.y = DEFAULT_Y;
+    projectile.x = FIXED(DEFAULT_X);
+    projectile.y = FIXED(DEFAULT_Y);
+    projectile_aim(&projectile, position, 0, 0);
     return projectile;
 }
 
 
-/** Displays the ball at the specified coordinates.
-    @param x x-coordinate of the ball
-    @param y y-coordinate of the ball */
-void display_point(int8_t x, int8_t y)
+/** Points the ball along a heading at a speed level.
+    @param projectile Projectile object to aim
+    @param heading Start_Position giving the direction
+    @param speed Speed level, 0 to SPEED_LEVELS - 1
+    @param down 1 to move towards the paddle, 0 to move away from it */
+void projectile_aim(Projectile* projectile, Start_Position heading, uint8_t speed, bool down)
 {
-    ledmat_display_column((1<<(6 - x)), 4 - y);
+    fixed_t cells_per_step = BALL_BASE_SPEED + speed * BALL_SPEED_STEP;
+    projectile->heading = heading;
+    projectile->speed = speed;
+    projectile->delta_x = FIXED_MUL(serve_lookup(heading, SERVE_DIRECTION_X), cells_per_step);
+    projectile->delta_y = FIXED_MUL(serve_lookup(heading, SERVE_DIRECTION_Y), cells_per_step);
+    if (down) {
+        projectile->delta_y = -projectile->delta_y;
+    }
 }
 
 
-/** Displays the ball at the chosen starting position.
-    @param position The starting coordinates of the ball */
-void display_start(Start_Position position)
+/** Sends the ball back up the court off a paddle, one speed level faster.
+    @param projectile Projectile object that hit the paddle
+    @param offset Where on the paddle it hit, -1 towards the top, 0 middle,
+    1 towards the bottom */
+void projectile_return(Projectile* projectile, int8_t offset)
 {
-    switch (position) {
-        case WNW:
-            display_point(1, 1);
-            break;
-        case NW:
-            display_point(1, 2);
-            break;
-        case NNW:
-            display_point(2, 2);
-            break;
-        case N:
-            display_point(3, 3);
-            break;
-        case NNE:
-            display_point(4, 2);
-            break;
-        case NE:
-            display_point(5, 2);
-            break;
-        case ENE:
-            display_point(5, 1);
-            break;
-        default:
-            display_point(3, 3);
-            break;
+#if PADDLE_LENGTH > BOUNCE_OFFSETS
+    //A longer paddle sends every off-centre hit the same way
+    if (offset < -BOUNCE_OFFSET_BIAS) {
+        offset = -BOUNCE_OFFSET_BIAS;
+    } else if (offset > BOUNCE_OFFSET_BIAS) {
+        offset = BOUNCE_OFFSET_BIAS;
     }
-}
+#endif
+    uint8_t heading = pgm_read_byte(&bounce_table[offset + BOUNCE_OFFSET_BIAS][projectile->heading]);
+    uint8_t speed = projectile->speed < SPEED_LEVELS - 1 ? projectile->speed + 1 : projectile->speed;
 
-/** Displays a sad face for the loser */
-void display_sad(void)
-{
-    uint16_t update_counter = 0;
-    //Sad face bit-map
-    uint8_t column_array[5] = {0x0, 0x36, 0x0, 0x1C, 0x22};
-    while (update_counter < SAD_FACE_WAIT_TIME) {
-        for (uint8_t i = 0; i < 5; i++) {
-            ledmat_display_column(column_array[i], i);
-        }
-        update_counter++;
-    }
-    ledmat_display_column(0x0, 4); //clears display
+    projectile_aim(projectile, heading, speed, 0); // bounce upward
 }
 
 
-/** Chooses the starting position of the ball.
-    @param state The current state of the game
-    @return the chosen starting coordinates of the ball. */
-Start_Position choose_start(State* state)
+/** Shows the ball at the serve spot, with the pixel in the chosen
+    direction blinking.
+    @param position The starting coordinates of the ball */
+void display_start(Start_Position position)
 {
-    Start_Position position = N;
-    bool not_done = 1;
-    while (not_done) {
-        //displays the starting direction with a pixel at the start, and a pixel in the direction you can choose
-        display_point(DEFAULT_X, DEFAULT_Y);
-        display_start(position);
-
-        //Cycles through start positions
-        navswitch_update ();
-        if (navswitch_push_event_p (NAVSWITCH_SOUTH) && position != 0) {
-            position -= 1;
-            display_start(position);
-        } else if (navswitch_push_event_p (NAVSWITCH_NORTH) && position != 6) {
-            position += 1;
-            display_start(position);
-        } else if (navswitch_push_event_p (NAVSWITCH_PUSH)) {
-            not_done = 0;
-            *state = GAME_ON;
-            return position;
-        }
+    if (position >= SERVE_COUNT) {
+        position = DEFAULT_SERVE;
     }
-
-    //Backup return statement
-    *state = GAME_ON;
-    return N;
+    anim_play(&serve_previews[position]);
 }
 
 
-/** Updates the position and checks for losing condition
-    @param projectile the address of the ball/Projectile object
-    @param paddle the address of the paddle object
-    @param state the address of the current state of the game */
-void update_pos(Projectile* projectile, Paddle* paddle, State* state)
+/** Lets the player choose the starting position of the ball, one tick
+    at a time. Waits for a one-shot animation, e.g. the sad face, to end
+    before showing the choice.
+    @param position Address of the position chosen so far, kept between calls
+    @param state The current state of the game, set to GAME_ON once chosen
+    @return 1 once the position has been chosen */
+bool choose_start(Start_Position* position, State* state)
 {
-    // Paddle collision check
-    if (proj_in_paddle(projectile, paddle)) {
-        projectile->y = 0;
-        projectile->delta_y *= -1; // bounce upward
-
-        // Adjust horizontal direction based on hit position
-        tinygl_coord_t top = get_paddle_top(paddle);
-        tinygl_coord_t bottom = get_paddle_bottom(paddle);
-        tinygl_coord_t mid = (top + bottom) / 2;
-
-        // If the ball hits near the top of the paddle, send it left
-        if (projectile->x < 6 - mid)
-            projectile->delta_x = -1;
-        // If the ball hits near the bottom, send it right
-        else if (projectile->x > 6 - mid)
-            projectile->delta_x = 1;
-        // Otherwise, retain angle
-        else
-            projectile->delta_x *= 1;
+    if (anim_busy()) {
+        return 0;
     }
 
-    // Bottom edge (miss / lose). Returns to ball select for the loser.
-    else if (projectile->y + projectile->delta_y < 0) {
-        display_sad();
-        pacer_wait();
-        *state = BALL_SELECT;
-    }
-
-    // Top edge, sends projectile to opponent, then waits for ball
-    else if (projectile->y + projectile->delta_y > 4) {
-        *state = WAITING;
-        send_projectile(projectile);
+    //Cycles through start positions
+    if (input_push_event_p(NAVSWITCH_SOUTH) && *position != 0) {
+        *position -= 1;
+    } else if (input_push_event_p(NAVSWITCH_NORTH) && *position != SERVE_COUNT - 1) {
+        *position += 1;
+    } else if (input_push_event_p(NAVSWITCH_PUSH)) {
+        anim_stop();
+        *state = GAME_ON;
+        return 1;
     }
+    display_start(*position);
+    return 0;
+}
 
-    // Left/right wall collision
+/** Bounces the ball off the left/right walls, mirroring the heading
+    @param projectile the address of the ball/Projectile object */
+static void bounce_walls(Projectile* projectile)
+{
     if (projectile->x + projectile->delta_x < 0) {
         projectile->x = 0;
         projectile->delta_x *= -1;
-    } else if (projectile->x + projectile->delta_x > 6) {
-        projectile->x = 6;
+        projectile->heading = SERVE_COUNT - 1 - projectile->heading;
+    } else if (projectile->x + projectile->delta_x > FIXED(COURT_MAX_X)) {
+        projectile->x = FIXED(COURT_MAX_X);
         projectile->delta_x *= -1;
+        projectile->heading = SERVE_COUNT - 1 - projectile->heading;
     }
-
-    // Move
-    projectile->x += projectile->delta_x;
-    projectile->y += projectile->delta_y;
 }
 
 
-/** Checks if the ball has hit the paddle
+/** Dead-reckons the ball forward, as if it had kept moving while it was
+    in flight to this court. Stops short of the paddle row, so hits and
+    misses are still left to ball_pool_step().
     @param projectile the address of the ball/Projectile object
-    @param paddle the address of the paddle object
-    @return returns 1 if ball has hit paddle*/
-bool proj_in_paddle(Projectile* projectile, Paddle* paddle)
+    @param steps number of ball steps to move it by */
+void projectile_advance(Projectile* projectile, uint16_t steps)
 {
-    bool x_coords_align = (6 - get_paddle_top(paddle) <= projectile->x) && (projectile->x <= 6 - get_paddle_bottom(paddle));
-
-    //makes sure paddle is hit, and is moving towards paddle
-    return x_coords_align && (projectile->y + projectile->delta_y <= 0) && (projectile->delta_y < 0); 
-}
-
-
-/** Draws the position of the ball in real-time
-    @param projectile address of the Projectile object. */
-void draw_projectile(const Projectile* projectile)
-{
-    display_point(projectile->x, projectile->y);
+    while (steps > 0 && projectile->y + projectile->delta_y > 0) {
+        bounce_walls(projectile);
+        projectile->x += projectile->delta_x;
+        projectile->y += projectile->delta_y;
+        steps--;
+    }
 }
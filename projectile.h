@@ -16,20 +16,37 @@
 #include <stdint.h>
 #include "paddle.h"
 #include "states.h"
+#include "court.h"
+#include "framebuffer.h"
+#include "fixed.h"
 
-//Defines a pojectile with (x,y) coords, and change in (x, y) per update
-typedef struct {
-    int8_t x;
-    int8_t y;
-    int8_t delta_x;
-    int8_t delta_y;
-} Projectile;
+/*Ball speed in cells per ball step (Q8.8). Each paddle return raises
+    the speed one level, up to the top level*/
+#define SPEED_LEVELS 5
+#define BALL_BASE_SPEED 51
+#define BALL_SPEED_STEP 13
 
-//Defines starting positions for projectile with compass positions
+//Defines starting positions for projectile with compass positions, from serves.def
 typedef enum {
-    WNW = 0, NW, NNW, N, NNE, NE, ENE
+#define SERVE(name, direction_x, direction_y, preview_dx, preview_y) name,
+#include "serves.def"
+#undef SERVE
+    SERVE_COUNT
 } Start_Position;
 
+#define DEFAULT_SERVE N
+
+/*Defines a pojectile with sub-pixel (x,y) coords, and change in (x, y) per update.
+    heading and speed are kept so the ball can be re-aimed and sent compactly*/
+typedef struct {
+    fixed_t x;
+    fixed_t y;
+    fixed_t delta_x;
+    fixed_t delta_y;
+    uint8_t heading;
+    uint8_t speed;
+} Projectile;
+
 
 /** Initialises the Projectile object.
     @param position The starting coordinates of the ball
@@ -37,41 +54,41 @@ typedef enum {
 Projectile projectile_init(Start_Position position);
 
 
-/** Displays the ball at the specified coordinates.
-    @param x x-coordinate of the ball
-    @param y y-coordinate of the ball */
-void display_point(int8_t x, int8_t y);
-
+/** Points the ball along a heading at a speed level.
+    @param projectile Projectile object to aim
+    @param heading Start_Position giving the direction
+    @param speed Speed level, 0 to SPEED_LEVELS - 1
+    @param down 1 to move towards the paddle, 0 to move away from it */
+void projectile_aim(Projectile* projectile, Start_Position heading, uint8_t speed, bool down);
 
-/** Displays the ball at the chosen starting position.
-    @param position The starting coordinates of the ball */
-void display_start(Start_Position position);
 
-void display_sad(void);
+/** Sends the ball back up the court off a paddle, one speed level faster.
+    @param projectile Projectile object that hit the paddle
+    @param offset Where on the paddle it hit, -1 towards the top, 0 middle,
+    1 towards the bottom */
+void projectile_return(Projectile* projectile, int8_t offset);
 
 
-/** Chooses the starting position of the ball.
-    @param state The current state of the game
-    @return the chosen starting coordinates of the ball. */
-Start_Position choose_start(State* state);
+/** Shows the ball at the serve spot, with the pixel in the chosen
+    direction blinking.
+    @param position The starting coordinates of the ball */
+void display_start(Start_Position position);
 
 
-/** Updates the position and checks for losing condition
-    @param projectile the address of the ball/Projectile object
-    @param paddle the address of the paddle object
-    @param state the address of the current state of the game */
-void update_pos(Projectile* projectile, Paddle* paddle, State* state);
+/** Lets the player choose the starting position of the ball, one tick
+    at a time. Waits for a one-shot animation, e.g. the sad face, to end
+    before showing the choice.
+    @param position Address of the position chosen so far, kept between calls
+    @param state The current state of the game, set to GAME_ON once chosen
+    @return 1 once the position has been chosen */
+bool choose_start(Start_Position* position, State* state);
 
 
-/** Checks if the ball has hit the paddle
+/** Dead-reckons the ball forward, as if it had kept moving while it was
+    in flight to this court. Stops short of the paddle row, so hits and
+    misses are still left to ball_pool_step().
     @param projectile the address of the ball/Projectile object
-    @param paddle the address of the paddle object
-    @return returns 1 if ball has hit paddle*/
-bool proj_in_paddle(Projectile* projectile, Paddle* paddle);
-
-
-/** Draws the position of the ball in real-time
-    @param projectile address of the Projectile object. */
-void draw_projectile(const Projectile* projectile);
+    @param steps number of ball steps to move it by */
+void projectile_advance(Projectile* projectile, uint16_t steps);
 
 #endif //PROJECTILE_H
\ No newline at end of file
@@ -0,0 +1,165 @@
+/** @file recorder.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Records game input so a match can be replayed exactly.
+*/
+
+#include <stdint.h>
+#include "system.h"
+#include "recorder.h"
+
+#ifdef __AVR__
+#include <avr/eeprom.h>
+#include "matchlog.h"
+
+//The recording fills EEPROM up to the match log
+#define EEPROM_COUNT_ADDRESS 0
+#define EEPROM_RECORDS_ADDRESS 2
+#define EEPROM_RECORDS ((MATCHLOG_ADDRESS - EEPROM_RECORDS_ADDRESS) / RECORD_SIZE)
+#endif
+
+/** Log waiting to be drained, oldest record at tail. */
+static Record records[RECORDER_CAPACITY];
+static uint8_t head;
+static uint8_t tail;
+static uint8_t count;
+static uint8_t dropped;
+
+/** Input ticks since the last record. */
+static uint16_t ticks;
+
+
+/** Empties the log and restarts the input tick counter. On the board
+    this also empties the recording kept in EEPROM. */
+void recorder_init(void)
+{
+    head = 0;
+    tail = 0;
+    count = 0;
+    dropped = 0;
+    ticks = 0;
+#ifdef __AVR__
+    eeprom_write_word((uint16_t*)EEPROM_COUNT_ADDRESS, 0);
+#endif
+}
+
+
+/** Adds a record to the log, or counts it as dropped if the log is full.
+    @param type Record type
+    @param data Record data byte */
+static void recorder_append(uint8_t type, uint8_t data)
+{
+    if (count == RECORDER_CAPACITY) {
+        dropped++;
+    } else {
+        records[head].delta = ticks;
+        records[head].type = type;
+        records[head].data = data;
+        head = (head + 1) % RECORDER_CAPACITY;
+        count++;
+    }
+    ticks = 0;
+}
+
+
+/** Counts one input tick. Called on every navswitch or IR poll. */
+void recorder_tick(void)
+{
+    ticks++;
+    if (ticks == RECORDER_MAX_DELTA) {
+        recorder_append(RECORD_IDLE, 0);
+    }
+}
+
+
+/** Logs an input against the current input tick.
+    @param type RECORD_PUSH, RECORD_RELEASE or RECORD_IR
+    @param data Navswitch button, or the IR byte received */
+void recorder_log(Record_Type type, uint8_t data)
+{
+    recorder_append(type, data);
+}
+
+
+/** Takes the oldest record out of the log.
+    @param record Record to write to
+    @return 1 if there was a record */
+bool recorder_read(Record* record)
+{
+    if (count == 0) {
+        return 0;
+    }
+    *record = records[tail];
+    tail = (tail + 1) % RECORDER_CAPACITY;
+    count--;
+    return 1;
+}
+
+
+/** Returns the number of records lost because the log was full.
+    A log with lost records cannot be replayed.
+    @return records dropped */
+uint8_t recorder_dropped(void)
+{
+    return dropped;
+}
+
+
+/** Packs a record into its four byte form.
+    @param record Record to pack
+    @param bytes Buffer of RECORD_SIZE bytes */
+void recorder_pack(const Record* record, uint8_t bytes[RECORD_SIZE])
+{
+    bytes[0] = record->delta & 0xFF;
+    bytes[1] = record->delta >> 8;
+    bytes[2] = record->type;
+    bytes[3] = record->data;
+}
+
+
+/** Unpacks a record from its four byte form.
+    @param bytes Buffer of RECORD_SIZE bytes
+    @param record Record to write to */
+void recorder_unpack(const uint8_t bytes[RECORD_SIZE], Record* record)
+{
+    record->delta = bytes[0] | (uint16_t)bytes[1] << 8;
+    record->type = bytes[2];
+    record->data = bytes[3];
+}
+
+
+#ifdef __AVR__
+/** Writes at most one byte of the log to EEPROM, when EEPROM is ready,
+    so it never stalls the caller. EEPROM holds a 16-bit record count
+    followed by the records. Only on the board. */
+void recorder_drain(void)
+{
+    static uint8_t bytes[RECORD_SIZE];
+    static uint8_t index = RECORD_SIZE + 2; //nothing in progress
+    static uint16_t written = 0;
+
+    if (!eeprom_is_ready()) {
+        return;
+    }
+
+    //Starts the next record, once the last one and the count are written
+    if (index == RECORD_SIZE + 2) {
+        Record record;
+        if (written >= EEPROM_RECORDS || !recorder_read(&record)) {
+            return;
+        }
+        recorder_pack(&record, bytes);
+        index = 0;
+    }
+
+    if (index < RECORD_SIZE) {
+        eeprom_write_byte((uint8_t*)(EEPROM_RECORDS_ADDRESS + written * RECORD_SIZE + index), bytes[index]);
+    } else if (index == RECORD_SIZE) {
+        written++;
+        eeprom_write_byte((uint8_t*)EEPROM_COUNT_ADDRESS, written & 0xFF);
+    } else {
+        eeprom_write_byte((uint8_t*)(EEPROM_COUNT_ADDRESS + 1), written >> 8);
+    }
+    index++;
+}
+#endif
@@ -0,0 +1,88 @@
+/** @file recorder.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Records game input so a match can be replayed exactly.
+
+    Every navswitch edge and every received IR byte is logged against an
+    input tick counter, which counts calls to input_update() and
+    input_ir_receive(). Replaying the same inputs at the same input ticks
+    drives the game down the same code paths, whatever the timing.
+
+    A record is four bytes: input ticks since the previous record (16 bits,
+    little endian), the record type and one data byte. Records wait in a
+    small ring buffer until drained, on the board into EEPROM, where
+    "make dump-recording" reads them back for host/replay.
+    Recording is compiled in only when RECORD is defined.
+*/
+
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include <stdint.h>
+#include "system.h"
+
+#define RECORD_SIZE 4
+#define RECORDER_CAPACITY 32
+#define RECORDER_MAX_DELTA 0xFFFF
+
+//Defines the kinds of record. RECORD_IDLE only carries elapsed input ticks.
+typedef enum {
+    RECORD_IDLE = 0,
+    RECORD_PUSH,
+    RECORD_RELEASE,
+    RECORD_IR
+} Record_Type;
+
+//Defines one logged input
+typedef struct {
+    uint16_t delta;
+    uint8_t type;
+    uint8_t data;
+} Record;
+
+
+/** Empties the log and restarts the input tick counter. On the board
+    this also empties the recording kept in EEPROM. */
+void recorder_init(void);
+
+
+/** Counts one input tick. Called on every navswitch or IR poll. */
+void recorder_tick(void);
+
+
+/** Logs an input against the current input tick.
+    @param type RECORD_PUSH, RECORD_RELEASE or RECORD_IR
+    @param data Navswitch button, or the IR byte received */
+void recorder_log(Record_Type type, uint8_t data);
+
+
+/** Takes the oldest record out of the log.
+    @param record Record to write to
+    @return 1 if there was a record */
+bool recorder_read(Record* record);
+
+
+/** Returns the number of records lost because the log was full.
+    A log with lost records cannot be replayed.
+    @return records dropped */
+uint8_t recorder_dropped(void);
+
+
+/** Packs a record into its four byte form.
+    @param record Record to pack
+    @param bytes Buffer of RECORD_SIZE bytes */
+void recorder_pack(const Record* record, uint8_t bytes[RECORD_SIZE]);
+
+
+/** Unpacks a record from its four byte form.
+    @param bytes Buffer of RECORD_SIZE bytes
+    @param record Record to write to */
+void recorder_unpack(const uint8_t bytes[RECORD_SIZE], Record* record);
+
+
+/** Writes at most one byte of the log to EEPROM, when EEPROM is ready,
+    so it never stalls the caller. EEPROM holds a 16-bit record count
+    followed by the records. Only on the board. */
+void recorder_drain(void);
+
+#endif //RECORDER_H
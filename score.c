@@ -0,0 +1,101 @@
+/** @file score.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Keeps the score of a match, point by point.
+*/
+
+#include <stdint.h>
+#include "system.h"
+#include "states.h"
+#include "balls.h"
+#include "court.h"
+#include "transport.h"
+#include "ir_transmission.h"
+#include "matchlog.h"
+#include "score.h"
+
+
+/** Ends a point. The board that missed serves next.
+    @param match Match whose score is kept
+    @param last Point last ended, set to this one
+    @param lost 1 if this board missed */
+void score_end_point(Match_Record* match, Last_Point* last, bool lost)
+{
+    last->served = match->serving;
+    if (lost) {
+        match->lost++;
+    }
+    match->serving = lost;
+    match->points++;
+}
+
+
+/** Ends the point this board has just missed, and tells the opponent,
+    or leaves it to score_keep() to tell it if the outbox is full. Balls
+    still in play are out with the point, and the bricks come back.
+    @param match Match whose score is kept
+    @param last Point last ended, set to this one
+    @param state Game state. Changed to BALL_SELECT, to serve next
+    @param balls Ball pool of this court
+    @param court Court to load the level into again
+    @param level Level of this court
+    @param transport Transport the miss is sent on, or NULL with no opponent board */
+void score_miss(Match_Record* match, Last_Point* last, State* state, Ball_Pool* balls, Court_Map* court,
+                Level level, Transport* transport)
+{
+    ball_pool_clear(balls);
+    court_load(court, level);
+    score_end_point(match, last, 1);
+    last->unsent = transport && !send_point(transport, match->lost);
+    *state = BALL_SELECT;
+}
+
+
+/** Keeps the score when the opponent misses, and answers it if it has
+    been reset and asks to resume. Two player modes only. Balls still in
+    play here are out with the point, as when this board misses, and
+    the bricks come back. If both boards missed before hearing of the
+    other's miss, both count the server's miss alone, so the point is
+    only played once. A miss score_miss() could not send is sent here.
+    Call once per tick in BALL_SELECT, WAITING and GAME_ON, after
+    transport_poll().
+    @param match Match whose score is kept
+    @param last Point last ended. Updated when a point ends
+    @param state Game state. Changed to WAITING when the opponent serves next
+    @param balls Ball pool of this court
+    @param court Court to load the level into again
+    @param level Level of this court
+    @param transport Transport the opponent's messages arrive on
+    @param pairing Pairing that decided who served first, if any
+    @return 1 if the score changed */
+bool score_keep(Match_Record* match, Last_Point* last, State* state, Ball_Pool* balls, Court_Map* court,
+                Level level, Transport* transport, const Pairing* pairing)
+{
+    uint8_t opponent_lost;
+    //Sent again on the next tick if the outbox is full
+    if (last->unsent) {
+        last->unsent = !send_point(transport, match->lost);
+    }
+    if (!receive_match(transport, match, pairing, &opponent_lost)) {
+        return 0;
+    }
+    if (*state != BALL_SELECT) {
+        match->won = opponent_lost;
+        score_end_point(match, last, 0);
+        ball_pool_clear(balls);
+        court_load(court, level);
+        *state = WAITING;
+        return 1;
+    }
+    if (!last->served) {
+        //This board's miss is taken back, and it waits for the serve. A
+        //miss not yet sent never will be
+        last->unsent = 0;
+        match->lost--;
+        match->won = opponent_lost;
+        match->serving = 0;
+        *state = WAITING;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+/** @file score.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Keeps the score of a match, point by point.
+
+    game.c and the rally simulator both keep the score through here, so
+    the simulator checks the scoring the firmware runs. Nothing here
+    saves the match; a caller that keeps it in EEPROM saves it whenever
+    a call reports the score changed.
+*/
+
+#ifndef SCORE_H
+#define SCORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "system.h"
+#include "states.h"
+#include "balls.h"
+#include "court.h"
+#include "transport.h"
+#include "ir_transmission.h"
+#include "matchlog.h"
+
+//Defines what is kept of the point last ended, between ticks
+typedef struct {
+    bool served;  //1 if this board served it
+    bool unsent;  //1 while this board's miss is not yet sent to the opponent
+} Last_Point;
+
+
+/** Ends a point. The board that missed serves next.
+    @param match Match whose score is kept
+    @param last Point last ended, set to this one
+    @param lost 1 if this board missed */
+void score_end_point(Match_Record* match, Last_Point* last, bool lost);
+
+
+/** Ends the point this board has just missed, and tells the opponent,
+    or leaves it to score_keep() to tell it if the outbox is full. Balls
+    still in play are out with the point, and the bricks come back.
+    @param match Match whose score is kept
+    @param last Point last ended, set to this one
+    @param state Game state. Changed to BALL_SELECT, to serve next
+    @param balls Ball pool of this court
+    @param court Court to load the level into again
+    @param level Level of this court
+    @param transport Transport the miss is sent on, or NULL with no opponent board */
+void score_miss(Match_Record* match, Last_Point* last, State* state, Ball_Pool* balls, Court_Map* court,
+                Level level, Transport* transport);
+
+
+/** Keeps the score when the opponent misses, and answers it if it has
+    been reset and asks to resume. Two player modes only. Balls still in
+    play here are out with the point, as when this board misses, and
+    the bricks come back. If both boards missed before hearing of the
+    other's miss, both count the server's miss alone, so the point is
+    only played once. A miss score_miss() could not send is sent here.
+    Call once per tick in BALL_SELECT, WAITING and GAME_ON, after
+    transport_poll().
+    @param match Match whose score is kept
+    @param last Point last ended. Updated when a point ends
+    @param state Game state. Changed to WAITING when the opponent serves next
+    @param balls Ball pool of this court
+    @param court Court to load the level into again
+    @param level Level of this court
+    @param transport Transport the opponent's messages arrive on
+    @param pairing Pairing that decided who served first, if any
+    @return 1 if the score changed */
+bool score_keep(Match_Record* match, Last_Point* last, State* state, Ball_Pool* balls, Court_Map* court,
+                Level level, Transport* transport, const Pairing* pairing);
+
+#endif //SCORE_H
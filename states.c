@@ -5,28 +5,88 @@
 */
 
 
-#include "tinygl.h"
+#include <avr/pgmspace.h>
 #include "states.h"
 #include "navswitch.h"
-#include "pacer.h"
-#include "../fonts/font5x7_1.h"
-
-#define TEXT_SPEED 20
+#include "input.h"
+#include "framebuffer.h"
+#include "text.h"
+#include "assets.h"
 
 /** While in the BEGIN state, the player is prompted
     via scrolling text to press the navswitch to start 
-    the game.
-    @param state address of the current state of the game. */
-void press_to_start(void)
+    the game. Call once per tick in BEGIN and PRESS_TO_START.
+    @param state address of the current state of the game,
+    MODE_SELECT once the navswitch is pushed. */
+void press_to_start(State* state)
+{
+    if (*state == BEGIN) {
+        //Only the text is shown until the result of the handshake
+        framebuffer_show(1 << LAYER_OVERLAY);
+        text_scroll_P(text_PRESS_TO_START);
+        *state = PRESS_TO_START;
+    } else if (input_push_event_p(NAVSWITCH_PUSH)) {
+        text_clear();
+        *state = MODE_SELECT;
+    }
+}
+
+
+/** Lets the player choose between two players, by IR, one player
+    against the AI, and two players with multi-ball. Call once per tick
+    in MODE_SELECT.
+    @param state address of the current state of the game, LEVEL_SELECT
+    once a mode is chosen
+    @param mode address of the choice so far, kept between calls */
+void select_mode(State* state, Game_Mode* mode)
 {
-    tinygl_font_set(&font5x7_1);
-    tinygl_text_speed_set(TEXT_SPEED);
-    tinygl_text_mode_set(TINYGL_TEXT_MODE_SCROLL);
-    tinygl_text("PRESS TO START");
-
-    while(!navswitch_push_event_p(NAVSWITCH_PUSH)) {
-        pacer_wait();
-        tinygl_update();
-        navswitch_update();
+    if (input_push_event_p(NAVSWITCH_SOUTH)) {
+        *mode = (*mode + MODE_COUNT - 1) % MODE_COUNT;
+    } else if (input_push_event_p(NAVSWITCH_NORTH)) {
+        *mode = (*mode + 1) % MODE_COUNT;
+    } else if (input_push_event_p(NAVSWITCH_PUSH)) {
+        text_clear();
+        framebuffer_show(1 << LAYER_COURT);
+        *state = LEVEL_SELECT;
+        return;
     }
+    text_char(pgm_read_byte(&text_MODE_CHOICES[*mode]));
+}
+
+
+/** Lets the player choose the obstacles on their court, previewing each
+    level on the matrix. Call once per tick in LEVEL_SELECT.
+    @param state address of the current state of the game, PAIRING
+    once a level is chosen in a two player mode, or BALL_SELECT for one
+    player
+    @param level address of the choice so far, kept between calls
+    @param map address of the court, loaded with the level shown
+    @param mode mode chosen in MODE_SELECT */
+void select_level(State* state, Level* level, Court_Map* map, Game_Mode mode)
+{
+    if (input_push_event_p(NAVSWITCH_SOUTH)) {
+        *level = (*level + LEVEL_COUNT - 1) % LEVEL_COUNT;
+        court_load(map, *level);
+    } else if (input_push_event_p(NAVSWITCH_NORTH)) {
+        *level = (*level + 1) % LEVEL_COUNT;
+        court_load(map, *level);
+    } else if (input_push_event_p(NAVSWITCH_PUSH)) {
+        if (mode == MODE_ONE_PLAYER) {
+            //No handshake, the player serves first
+            framebuffer_show(FRAMEBUFFER_ALL_LAYERS);
+            *state = BALL_SELECT;
+        } else {
+            framebuffer_show(1 << LAYER_OVERLAY);
+            *state = PAIRING;
+        }
+    }
+}
+
+
+/** Checks if the paddle can be moved in a state.
+    @param state State to check
+    @return 1 while a ball is in play or on its way */
+bool state_paddle_free_p(State state)
+{
+    return state == WAITING || state == GAME_ON;
 }
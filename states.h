@@ -7,25 +7,74 @@
     We have modelled the game as a state machine with various states
     for the sake of modularity. This is essentially the "hub" and where
     all the state data and functions are kept. 
+    Every state does a bounded amount of work per tick of game_state()
+    and returns, so the display, input and IR are serviced on every
+    screen. Multi-step flows such as the PSR handshake have a state for
+    each step.
 */
 
 #ifndef STATES_H
 #define STATES_H
 #include <stdint.h>
+#include "system.h"
+#include "court.h"
 
 //Defines posiible game states
 typedef enum {
-    BEGIN,
+    BEGIN,           //shows the start prompt
+    PRESS_TO_START,  //waits for the navswitch to be pushed
+    RESUME,          //asks the opponent to carry on the match saved in EEPROM
+    MODE_SELECT,     //choosing one or two players
+    LEVEL_SELECT,    //choosing the obstacles on the court
+    PAIRING,         //deciding who serves automatically, by exchanging nonces
+    PSR_SELECT,      //choosing paper, scissors or rock
+    PSR_READY,       //chosen, waits for a push to send it
+    PSR_RESULT,      //sent, waits for the opponent's choice
     BALL_SELECT,
     WAITING,
     GAME_ON
 } State;
 
+//Defines the game modes, in the order of text_MODE_CHOICES
+typedef enum {
+    MODE_TWO_PLAYER,  //against another board over IR
+    MODE_ONE_PLAYER,  //against the AI
+    MODE_MULTI_BALL,  //two players, serving MULTI_BALL_COUNT balls at once
+    MODE_COUNT
+} Game_Mode;
+
 
 /** While in the BEGIN state, the player is prompted
     via scrolling text to press the navswitch to start 
-    the game.
-    @param state address of the current state of the game. */
-void press_to_start(void);
+    the game. Call once per tick in BEGIN and PRESS_TO_START.
+    @param state address of the current state of the game,
+    MODE_SELECT once the navswitch is pushed. */
+void press_to_start(State* state);
+
+
+/** Lets the player choose between two players, by IR, one player
+    against the AI, and two players with multi-ball. Call once per tick
+    in MODE_SELECT.
+    @param state address of the current state of the game, LEVEL_SELECT
+    once a mode is chosen
+    @param mode address of the choice so far, kept between calls */
+void select_mode(State* state, Game_Mode* mode);
+
+
+/** Lets the player choose the obstacles on their court, previewing each
+    level on the matrix. Call once per tick in LEVEL_SELECT.
+    @param state address of the current state of the game, PAIRING
+    once a level is chosen in a two player mode, or BALL_SELECT for one
+    player
+    @param level address of the choice so far, kept between calls
+    @param map address of the court, loaded with the level shown
+    @param mode mode chosen in MODE_SELECT */
+void select_level(State* state, Level* level, Court_Map* map, Game_Mode mode);
+
+
+/** Checks if the paddle can be moved in a state.
+    @param state State to check
+    @return 1 while a ball is in play or on its way */
+bool state_paddle_free_p(State state);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,143 @@
+/** @file text.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Scrolling text on the framebuffer's overlay layer.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "system.h"
+#include "framebuffer.h"
+#include "glyphs.h"
+#include "text.h"
+
+#define CHARACTER_COLUMNS (GLYPH_WIDTH + 1) //glyph and a blank column
+
+/** String being scrolled, and whether it is in program memory. */
+static const char* message;
+static bool message_in_flash;
+static uint16_t message_columns;
+
+/** Message column at the left edge of the display, negative while the
+    message is still entering from the right. */
+static int16_t offset;
+
+static uint16_t updates_per_column;
+static uint16_t updates;
+
+
+/** Reads one character of the message.
+    @param index Character to read
+    @return the character */
+static char message_char(uint16_t index)
+{
+    return message_in_flash ? pgm_read_byte(message + index) : message[index];
+}
+
+
+/** Looks up the pixels of one column of a character.
+    @param character Character to draw
+    @param col Column of the glyph, 0 to GLYPH_WIDTH - 1
+    @return column bitmap, blank if there is no glyph */
+static uint8_t glyph_column(char character, uint8_t col)
+{
+    for (uint8_t glyph = 0; glyph < GLYPH_COUNT; glyph++) {
+        if (pgm_read_byte(&glyph_characters[glyph]) == character) {
+            return pgm_read_byte(&glyph_columns[glyph][col]);
+        }
+    }
+    return 0;
+}
+
+
+/** Draws the part of the message under the display. */
+static void draw_message(void)
+{
+    for (uint8_t col = 0; col < FRAMEBUFFER_COLS; col++) {
+        int16_t column = offset + col;
+        uint8_t pattern = 0;
+        if (column >= 0 && (uint16_t)column < message_columns
+            && column % CHARACTER_COLUMNS < GLYPH_WIDTH) {
+            pattern = glyph_column(message_char(column / CHARACTER_COLUMNS), column % CHARACTER_COLUMNS);
+        }
+        framebuffer_column(LAYER_OVERLAY, col, pattern);
+    }
+}
+
+
+/** Starts a scroll of the current message from the right edge. */
+static void start_scroll(void)
+{
+    uint16_t length = 0;
+    while (message_char(length) != '\0') {
+        length++;
+    }
+    message_columns = length * CHARACTER_COLUMNS;
+    offset = -FRAMEBUFFER_COLS;
+    updates = 0;
+    draw_message();
+}
+
+
+/** Sets how often text_update() is called.
+    @param update_rate text_update() calls per second */
+void text_init(uint16_t update_rate)
+{
+    updates_per_column = update_rate / TEXT_COLUMN_RATE;
+    message = NULL;
+}
+
+
+/** Starts scrolling a string kept in program memory, e.g. text_NAME.
+    @param text String in program memory */
+void text_scroll_P(const char* text)
+{
+    message = text;
+    message_in_flash = 1;
+    start_scroll();
+}
+
+
+/** Starts scrolling a string kept in RAM.
+    @param text String in RAM, which must outlive the scroll */
+void text_scroll(const char* text)
+{
+    message = text;
+    message_in_flash = 0;
+    start_scroll();
+}
+
+
+/** Shows one character, still, stopping any scroll.
+    @param character Character to show */
+void text_char(char character)
+{
+    message = NULL;
+    for (uint8_t col = 0; col < FRAMEBUFFER_COLS; col++) {
+        framebuffer_column(LAYER_OVERLAY, col, col < GLYPH_WIDTH ? glyph_column(character, col) : 0);
+    }
+}
+
+
+/** Moves scrolling text on when it is due. Call at the update rate. */
+void text_update(void)
+{
+    if (message == NULL || ++updates < updates_per_column) {
+        return;
+    }
+    updates = 0;
+    offset++;
+    if (offset >= (int16_t)message_columns) {
+        offset = -FRAMEBUFFER_COLS;
+    }
+    draw_message();
+}
+
+
+/** Stops any scroll and clears the text from the display. */
+void text_clear(void)
+{
+    message = NULL;
+    framebuffer_clear(LAYER_OVERLAY);
+}
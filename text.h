@@ -0,0 +1,47 @@
+/** @file text.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Scrolling text on the framebuffer's overlay layer.
+
+    Draws with the glyphs in glyphs.h, which host/mkassets builds from
+    just the characters assets.def uses. Characters without a glyph are
+    drawn blank. Scrolling text enters from the right and repeats.
+*/
+
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <stdint.h>
+#include "system.h"
+
+#define TEXT_COLUMN_RATE 12  //columns scrolled per second
+
+
+/** Sets how often text_update() is called.
+    @param update_rate text_update() calls per second */
+void text_init(uint16_t update_rate);
+
+
+/** Starts scrolling a string kept in program memory, e.g. text_NAME.
+    @param text String in program memory */
+void text_scroll_P(const char* text);
+
+
+/** Starts scrolling a string kept in RAM.
+    @param text String in RAM, which must outlive the scroll */
+void text_scroll(const char* text);
+
+
+/** Shows one character, still, stopping any scroll.
+    @param character Character to show */
+void text_char(char character);
+
+
+/** Moves scrolling text on when it is due. Call at the update rate. */
+void text_update(void);
+
+
+/** Stops any scroll and clears the text from the display. */
+void text_clear(void);
+
+#endif //TEXT_H
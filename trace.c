@@ -0,0 +1,67 @@
+/** @file trace.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Binary trace of game events, for working out what went wrong.
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "system.h"
+#include "trace.h"
+
+#ifdef TRACE
+
+#ifdef __AVR__
+#include <avr/eeprom.h>
+
+//The saved trace takes the bottom of EEPROM, as a recording would
+#ifdef RECORD
+#error "TRACE and RECORD both keep their logs at the bottom of EEPROM"
+#endif
+#define TRACE_EEPROM_ADDRESS 0
+
+//Kept through a reset, so the trace leading up to it can be saved
+#define TRACE_SECTION __attribute__((section(".noinit")))
+#else
+#define TRACE_SECTION
+#endif
+
+Trace_Buffer trace_buffer TRACE_SECTION;
+
+
+/** Saves the trace left from before a reset, if there is one, then
+    starts an empty one. */
+void trace_init(void)
+{
+#ifdef __AVR__
+    //After power up the ring holds noise, which the magic number rules out.
+    //Only changed bytes are written, taking up to a few hundred ms
+    if (trace_buffer.magic == TRACE_MAGIC && trace_buffer.version == TRACE_VERSION) {
+        eeprom_update_block(&trace_buffer, (void*)TRACE_EEPROM_ADDRESS, sizeof(trace_buffer));
+    }
+#endif
+    memset(&trace_buffer, 0, sizeof(trace_buffer));
+    trace_buffer.magic = TRACE_MAGIC;
+    trace_buffer.version = TRACE_VERSION;
+}
+
+
+/** Packs the trace into its dump form.
+    @param bytes Buffer of TRACE_DUMP_SIZE bytes */
+void trace_pack(uint8_t bytes[TRACE_DUMP_SIZE])
+{
+    bytes[0] = trace_buffer.magic & 0xFF;
+    bytes[1] = trace_buffer.magic >> 8;
+    bytes[2] = trace_buffer.version;
+    bytes[3] = trace_buffer.head;
+    for (uint8_t i = 0; i < TRACE_SIZE; i++) {
+        const Trace_Record* record = &trace_buffer.records[i];
+        uint8_t* packed = &bytes[4 + i * TRACE_RECORD_SIZE];
+        packed[0] = record->tick & 0xFF;
+        packed[1] = record->tick >> 8;
+        packed[2] = record->type;
+        packed[3] = record->data;
+    }
+}
+
+#endif
@@ -0,0 +1,113 @@
+/** @file trace.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Binary trace of game events, for working out what went wrong.
+
+    Built with TRACE defined, TRACE_EVENT() writes a four byte record (the
+    timer tick, the event type and one data byte) into a ring of the last
+    TRACE_SIZE records in RAM: every state change, ball sent to and taken
+    from the other board, acknowledgement, paddle hit and miss. A record
+    is a handful of stores, inlined, so tracing can be left on in real
+    matches. Without TRACE the macro is empty and nothing is compiled in.
+
+    On the board the ring is not cleared by a reset, so after a match
+    goes wrong, pressing reset keeps the trace leading up to it.
+    trace_init() copies it to the bottom of EEPROM before starting a new
+    one, where "make dump-trace" reads it back for host/tracedump. On the
+    host, "host/replay -t" writes the trace at the end of a replay; the
+    simulators run several courts, which would share the one ring.
+
+    A dump is the little endian trace buffer as laid out below:
+    TRACE_MAGIC, the version, the index of the next record to write, then
+    the ring. Ticks wrap every 2^16 timer ticks, about 8 s, so the decoder
+    assumes consecutive records are closer than that.
+*/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include "system.h"
+#include "timer.h"
+
+#define TRACE_SIZE 32 //records, a power of two
+#define TRACE_RECORD_SIZE 4
+#define TRACE_MAGIC 0x5254
+#define TRACE_VERSION 1
+#define TRACE_DUMP_SIZE (4 + TRACE_SIZE * TRACE_RECORD_SIZE)
+
+/*Data bytes. A handoff carries the ball ID and its transport sequence
+    number, or TRACE_NO_SEQ if the outbox was full. Hits and misses carry
+    a mask of the balls and the bottom row of the paddle*/
+#define TRACE_HANDOFF(id, seq) ((uint8_t)((id) << 4 | (seq)))
+#define TRACE_HANDOFF_ID(data) ((data) >> 4)
+#define TRACE_HANDOFF_SEQ(data) ((data) & 0x0F)
+#define TRACE_NO_SEQ 0x0F
+#define TRACE_PADDLE(balls, bottom) ((uint8_t)((bottom) << 4 | (balls)))
+#define TRACE_PADDLE_BALLS(data) ((data) & 0x0F)
+#define TRACE_PADDLE_BOTTOM(data) ((data) >> 4)
+#define TRACE_DROPPED 0x80 //on a received ball ID, when its slot was in use
+
+//Defines the events traced, and their data bytes
+typedef enum {
+    TRACE_NONE = 0,   //slot not yet written
+    TRACE_STATE,      //new State
+    TRACE_SEND,       //send_projectile(), TRACE_HANDOFF()
+    TRACE_ACK,        //acknowledgement of a message sent, its sequence number
+    TRACE_RECEIVE,    //ball taken by wait_for_data(), ID | TRACE_DROPPED
+    TRACE_HIT,        //balls returned, TRACE_PADDLE()
+    TRACE_MISS,       //balls missed, TRACE_PADDLE()
+    TRACE_TYPES
+} Trace_Type;
+
+//Defines one traced event
+typedef struct {
+    uint16_t tick;    //timer_get() when it happened
+    uint8_t type;
+    uint8_t data;
+} Trace_Record;
+
+//Defines the ring of records, in its dump layout on the board
+typedef struct {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t head;     //next record to write; the oldest once the ring is full
+    Trace_Record records[TRACE_SIZE];
+} Trace_Buffer;
+
+#ifdef TRACE
+
+#define TRACE_EVENT(type, data) trace_log(type, data)
+
+extern Trace_Buffer trace_buffer;
+
+
+/** Saves the trace left from before a reset, if there is one, then
+    starts an empty one. */
+void trace_init(void);
+
+
+/** Adds a record to the ring, over the oldest once it is full.
+    @param type Event traced
+    @param data Its data byte */
+static inline void trace_log(Trace_Type type, uint8_t data)
+{
+    Trace_Record* record = &trace_buffer.records[trace_buffer.head];
+    record->tick = timer_get();
+    record->type = type;
+    record->data = data;
+    trace_buffer.head = (trace_buffer.head + 1) & (TRACE_SIZE - 1);
+}
+
+
+/** Packs the trace into its dump form.
+    @param bytes Buffer of TRACE_DUMP_SIZE bytes */
+void trace_pack(uint8_t bytes[TRACE_DUMP_SIZE]);
+
+#else
+
+#define TRACE_EVENT(type, data)
+
+#endif
+
+#endif //TRACE_H
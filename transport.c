@@ -0,0 +1,206 @@
+/** @file transport.c
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Reliable delivery of packets over the link.
+*/
+
+#include <stdint.h>
+#include "system.h"
+#include "timer.h"
+#include "packet.h"
+#include "link.h"
+#include "transport.h"
+#include "trace.h"
+
+
+/** Sends one packet over the link, high byte first.
+    @param packet Packet to send */
+static void transmit(const Packet* packet)
+{
+    uint32_t frame = packet_frame(packet);
+    for (int8_t shift = (PACKET_SIZE - 1) * 8; shift >= 0; shift -= 8) {
+        link_send(frame >> shift);
+    }
+}
+
+
+/** Sends the message at the head of the outbox, or the ACK_SYNC until
+    it is answered, and starts its wait.
+    @param transport Address of the Transport object. */
+static void transmit_head(Transport* transport)
+{
+    if (transport->sync == TRANSPORT_SYNCED) {
+        transmit(&transport->outbox[transport->outbox_head]);
+    } else {
+        Packet sync = {.type = PACKET_ACK, .payload = ACK_SYNC};
+        transmit(&sync);
+        transport->sync = TRANSPORT_SYNCING;
+    }
+    transport->deadline = timer_get() + (TRANSPORT_TIMEOUT << transport->backoff);
+}
+
+
+/** Handles a valid packet from the other board.
+    @param transport Address of the Transport object.
+    @param packet Packet received
+    @param byte_gap Timer ticks between its last two bytes */
+static void handle(Transport* transport, const Packet* packet, timer_tick_t byte_gap)
+{
+    //The other board was reset, and numbers its messages from 0 again
+    if (packet->type == PACKET_ACK && packet->payload == ACK_SYNC) {
+        Packet synced = {.type = PACKET_ACK, .payload = ACK_SYNCED};
+        transmit(&synced);
+        transport->delivered_any = 0;
+        return;
+    }
+
+    //The other board has forgotten what it delivered, so messages can flow
+    if (packet->type == PACKET_ACK && packet->payload == ACK_SYNCED) {
+        if (transport->sync == TRANSPORT_SYNCING) {
+            transport->sync = TRANSPORT_SYNCED;
+            transport->backoff = 0;
+            if (transport->outbox_count > 0) {
+                transmit_head(transport);
+            }
+        }
+        return;
+    }
+
+    //An acknowledgement frees the outbox for the next message
+    if (packet->type == PACKET_ACK) {
+        if (transport->sync == TRANSPORT_SYNCED && transport->outbox_count > 0
+            && transport->outbox[transport->outbox_head].seq == packet->seq) {
+            transport->outbox_head = (transport->outbox_head + 1) % TRANSPORT_OUTBOX_SIZE;
+            transport->outbox_count--;
+            transport->backoff = 0;
+            transport->stats.acked++;
+            TRACE_EVENT(TRACE_ACK, packet->seq);
+            if (transport->outbox_count > 0) {
+                transmit_head(transport);
+            }
+        }
+        return;
+    }
+
+    //Repeats are acknowledged again, as the last acknowledgement was lost.
+    //A message with no room in the inbox is left unacknowledged, to come again
+    bool repeat = transport->delivered_any && packet->seq == transport->delivered_seq;
+    if (!repeat && transport->inbox_count == TRANSPORT_INBOX_SIZE) {
+        return;
+    }
+    Packet ack = {.type = PACKET_ACK, .seq = packet->seq};
+    transmit(&ack);
+    if (repeat) {
+        transport->stats.duplicates++;
+        return;
+    }
+    transport->inbox[transport->inbox_count].packet = *packet;
+    transport->inbox[transport->inbox_count].byte_gap = byte_gap;
+    transport->inbox_count++;
+    transport->delivered_seq = packet->seq;
+    transport->delivered_any = 1;
+    transport->stats.delivered++;
+}
+
+
+/** Empties a transport, forgetting every message and zeroing its counters.
+    Messages queued are held until the other board answers an ACK_SYNC,
+    which the next transport_poll() sends.
+    @param transport Address of the Transport object. */
+void transport_reset(Transport* transport)
+{
+    *transport = (Transport){0};
+    packet_receiver_reset(&transport->receiver);
+}
+
+
+/** Queues a message for reliable delivery, sending it at once if nothing
+    else is in flight and the other board has answered the ACK_SYNC.
+    @param transport Address of the Transport object.
+    @param type PACKET_PROJECTILE or PACKET_MATCH
+    @param payload 12-bit payload
+    @return 1 if queued, 0 if the outbox is full */
+bool transport_send(Transport* transport, Packet_Type type, uint16_t payload)
+{
+    if (transport->outbox_count == TRANSPORT_OUTBOX_SIZE) {
+        transport->stats.overflows++;
+        return 0;
+    }
+    uint8_t tail = (transport->outbox_head + transport->outbox_count) % TRANSPORT_OUTBOX_SIZE;
+    transport->outbox[tail] = (Packet){.type = type, .seq = transport->next_seq, .payload = payload};
+    transport->next_seq = (transport->next_seq + 1) & PACKET_SEQ_MASK;
+    transport->outbox_count++;
+    transport->stats.sent++;
+    if (transport->outbox_count == 1 && transport->sync == TRANSPORT_SYNCED) {
+        transport->backoff = 0;
+        transmit_head(transport);
+    }
+    return 1;
+}
+
+
+/** Receives what has arrived, acknowledges it, and retransmits the message
+    in flight if its wait is over. Never waits. Call on every tick.
+    @param transport Address of the Transport object. */
+void transport_poll(Transport* transport)
+{
+    Packet_Receiver* receiver = &transport->receiver;
+    Packet packet;
+    uint8_t data;
+
+    for (uint8_t i = 0; i < TRANSPORT_BYTES_PER_POLL && link_receive(&data); i++) {
+        timer_tick_t now = timer_get();
+        timer_tick_t byte_gap = now - receiver->byte_time;
+        receiver->byte_time = now;
+        if (packet_receiver_push(receiver, data, &packet)) {
+            handle(transport, &packet, byte_gap);
+        }
+    }
+
+    //The first ACK_SYNC goes out at once
+    if (transport->sync == TRANSPORT_RESET) {
+        transmit_head(transport);
+    } else if (transport_busy_p(transport) && (int16_t)(timer_get() - transport->deadline) >= 0) {
+        if (transport->backoff < TRANSPORT_MAX_BACKOFF) {
+            transport->backoff++;
+        }
+        transport->stats.retransmits++;
+        transmit_head(transport);
+    }
+}
+
+
+/** Takes the oldest delivered message of a type, if there is one.
+    @param transport Address of the Transport object.
+    @param type Type of message to take
+    @param payload Address to store its payload
+    @param byte_gap Address to store the timer ticks between its last two bytes, or NULL
+    @return 1 if a message was taken */
+bool transport_take(Transport* transport, Packet_Type type, uint16_t* payload, timer_tick_t* byte_gap)
+{
+    for (uint8_t i = 0; i < transport->inbox_count; i++) {
+        if (transport->inbox[i].packet.type != type) {
+            continue;
+        }
+        *payload = transport->inbox[i].packet.payload;
+        if (byte_gap) {
+            *byte_gap = transport->inbox[i].byte_gap;
+        }
+        //Keeps the rest in order
+        transport->inbox_count--;
+        for (; i < transport->inbox_count; i++) {
+            transport->inbox[i] = transport->inbox[i + 1];
+        }
+        return 1;
+    }
+    return 0;
+}
+
+
+/** Checks if a message, or the ACK_SYNC, is waiting for its acknowledgement.
+    @param transport Address of the Transport object.
+    @return 1 while a message is in flight, or until the other board answers the ACK_SYNC */
+bool transport_busy_p(const Transport* transport)
+{
+    return transport->outbox_count > 0 || transport->sync != TRANSPORT_SYNCED;
+}
@@ -0,0 +1,120 @@
+/** @file transport.h
+    @authors Kendrick Dela Cruz (kmd119),  Tio Sasanuma Howard (tsa95)
+    @date 17 October 2025
+    @brief Reliable delivery of packets over the link.
+
+    Sits between the game and link.h. Every message sent gets a sequence
+    number and is sent again until the other board acknowledges it, so a
+    lost or corrupt frame only delays it. Messages go one at a time, in
+    the order sent. A repeat of a message already delivered is
+    acknowledged again but not delivered twice.
+
+    The first retransmit is TRANSPORT_TIMEOUT ticks after sending, and
+    the wait doubles with each retry up to TRANSPORT_TIMEOUT shifted by
+    TRANSPORT_MAX_BACKOFF. Once the link works again, a message gets through
+    within that longest wait. transport_poll() must be called on every
+    tick, whatever the game is doing, to receive, acknowledge and
+    retransmit.
+
+    A board that is reset numbers its messages from 0 again, while the
+    other board still remembers the last one it delivered, and would take
+    the first new message for a repeat. So after transport_reset() nothing
+    is sent until an ACK_SYNC, repeated like a message, has been answered.
+    The board it reaches forgets the last sequence number delivered, and
+    frames arrive in order, so every message after it counts as new.
+*/
+
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <stdint.h>
+#include "system.h"
+#include "timer.h"
+#include "packet.h"
+
+/*Retransmit timing, in timer ticks. The first wait covers a frame each
+    way at IR speed, with room to spare*/
+#define TRANSPORT_TIMEOUT (TIMER_RATE / 16)
+#define TRANSPORT_MAX_BACKOFF 2
+#define TRANSPORT_OUTBOX_SIZE 4  //messages waiting to go, including the one in flight
+#define TRANSPORT_INBOX_SIZE 2   //messages delivered but not yet taken
+#define TRANSPORT_BYTES_PER_POLL PACKET_SIZE
+
+//Defines how far a transport is through starting afresh with the other board
+typedef enum {
+    TRANSPORT_RESET = 0,  //nothing sent since transport_reset()
+    TRANSPORT_SYNCING,    //ACK_SYNC sent, waiting for ACK_SYNCED
+    TRANSPORT_SYNCED      //messages can be sent
+} Transport_Sync;
+
+//Defines the transport counters, for tuning the timing
+typedef struct {
+    uint16_t sent;        //messages sent for the first time
+    uint16_t retransmits; //frames sent again after a timeout
+    uint16_t acked;       //messages acknowledged by the other board
+    uint16_t delivered;   //messages received and handed to the game
+    uint16_t duplicates;  //repeats of delivered messages, dropped
+    uint16_t overflows;   //messages not sent as the outbox was full
+} Transport_Stats;
+
+//Defines a message waiting in the inbox, with the gap between its last two bytes
+typedef struct {
+    Packet packet;
+    timer_tick_t byte_gap;
+} Transport_Message;
+
+//Defines one board's end of the link
+typedef struct {
+    Packet outbox[TRANSPORT_OUTBOX_SIZE];
+    uint8_t outbox_head;
+    uint8_t outbox_count;
+    Transport_Message inbox[TRANSPORT_INBOX_SIZE];
+    uint8_t inbox_count;
+    uint8_t next_seq;        //sequence number for the next message sent
+    uint8_t delivered_seq;   //sequence number of the last message delivered
+    bool delivered_any;
+    timer_tick_t deadline;   //when the message in flight is sent again
+    uint8_t backoff;
+    Transport_Sync sync;
+    Packet_Receiver receiver;
+    Transport_Stats stats;
+} Transport;
+
+
+/** Empties a transport, forgetting every message and zeroing its counters.
+    Messages queued are held until the other board answers an ACK_SYNC,
+    which the next transport_poll() sends.
+    @param transport Address of the Transport object. */
+void transport_reset(Transport* transport);
+
+
+/** Queues a message for reliable delivery, sending it at once if nothing
+    else is in flight and the other board has answered the ACK_SYNC.
+    @param transport Address of the Transport object.
+    @param type PACKET_PROJECTILE or PACKET_MATCH
+    @param payload 12-bit payload
+    @return 1 if queued, 0 if the outbox is full */
+bool transport_send(Transport* transport, Packet_Type type, uint16_t payload);
+
+
+/** Receives what has arrived, acknowledges it, and retransmits the message
+    in flight if its wait is over. Never waits. Call on every tick.
+    @param transport Address of the Transport object. */
+void transport_poll(Transport* transport);
+
+
+/** Takes the oldest delivered message of a type, if there is one.
+    @param transport Address of the Transport object.
+    @param type Type of message to take
+    @param payload Address to store its payload
+    @param byte_gap Address to store the timer ticks between its last two bytes, or NULL
+    @return 1 if a message was taken */
+bool transport_take(Transport* transport, Packet_Type type, uint16_t* payload, timer_tick_t* byte_gap);
+
+
+/** Checks if a message, or the ACK_SYNC, is waiting for its acknowledgement.
+    @param transport Address of the Transport object.
+    @return 1 while a message is in flight, or until the other board answers the ACK_SYNC */
+bool transport_busy_p(const Transport* transport);
+
+#endif //TRANSPORT_H